@@ -1,82 +1,350 @@
 ﻿// AeronBridge.cpp — MT5 Subscriber Bridge (C API) + binary decode + mapping + tick conversion
 
 #include "AeronBridge.h"
+#include "AeronBridgeCore.h"
 
 #include <aeron_client.h>
 #include <aeronc.h>
 #include <aeron_context.h>
 #include <aeron_subscription.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <cwchar>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
-#include <queue>
 #include <vector>
 
 // ===============================
-// Protocol (must match publisher)
+// Protocol (bridge-only frames; signal frame lives in AeronBridgeCore.h)
 // ===============================
-// From AeronSignalPublisher.cs / AeronSignalAddon.cs 
-static constexpr uint32_t MAGIC = 0xA330BEEF;
-static constexpr uint16_t VERSION = 1;
-static constexpr int FRAME_SIZE = 104;
-
-static constexpr int MAGIC_OFFSET = 0;        // int32
-static constexpr int VERSION_OFFSET = 4;      // int16
-static constexpr int ACTION_OFFSET = 6;       // int16
-static constexpr int TIMESTAMP_OFFSET = 8;    // int64 (ns-ish)
-static constexpr int LONG_SL_OFFSET = 16;     // int32
-static constexpr int SHORT_SL_OFFSET = 20;    // int32
-static constexpr int PROFIT_TARGET_OFFSET = 24;// int32
-static constexpr int QTY_OFFSET = 28;         // int32
-static constexpr int CONFIDENCE_OFFSET = 32;  // float32
-static constexpr int SYMBOL_OFFSET = 36;      // char[16]
-static constexpr int INSTRUMENT_OFFSET = 52;  // char[32]
-static constexpr int SOURCE_OFFSET = 84;      // char[16]
-
-static constexpr int SYMBOL_LEN = 16;
-static constexpr int INSTRUMENT_LEN = 32;
-static constexpr int SOURCE_LEN = 16;
+// Execution ack (MT5 -> signal publisher back-channel), separate magic so
+// signal subscribers never mistake an ack for a signal.
+static constexpr uint32_t ACK_MAGIC = 0xA330ACCE;
+static constexpr uint16_t ACK_VERSION = 1;
+static constexpr int ACK_FRAME_SIZE = 72;
+
+static constexpr int ACK_MAGIC_OFFSET = 0;         // int32
+static constexpr int ACK_VERSION_OFFSET = 4;       // int16
+static constexpr int ACK_FLAGS_OFFSET = 6;         // int16 (reserved)
+static constexpr int ACK_SIGNAL_TS_OFFSET = 8;     // int64 signal frame timestamp (correlation key)
+static constexpr int ACK_SIGNAL_ID_OFFSET = 16;    // int64 bridge-local signal id
+static constexpr int ACK_RESULT_OFFSET = 24;       // int32 MT5 trade retcode
+static constexpr int ACK_RESERVED_OFFSET = 28;     // int32
+static constexpr int ACK_FILL_PRICE_OFFSET = 32;   // float64
+static constexpr int ACK_RECEIVE_NS_OFFSET = 40;   // int64 signal received by bridge (UTC ns)
+static constexpr int ACK_ACK_NS_OFFSET = 48;       // int64 ack published (UTC ns)
+static constexpr int ACK_TERMINAL_OFFSET = 56;     // char[16]
+
+static constexpr int TERMINAL_ID_LEN = 16;
+
+// Market-data quote (MT5 -> NinjaTrader): the broker's latest bid/ask per
+// symbol, conflated by the DLL quote sender. Own magic so signal subscribers
+// skip it.
+static constexpr uint32_t QUOTE_MAGIC = 0xA330B1DA;
+static constexpr uint16_t QUOTE_VERSION = 1;
+static constexpr int QUOTE_FRAME_SIZE = 88;
+
+static constexpr int QUOTE_MAGIC_OFFSET = 0;        // int32
+static constexpr int QUOTE_VERSION_OFFSET = 4;      // int16
+static constexpr int QUOTE_FLAGS_OFFSET = 6;        // int16 (reserved)
+static constexpr int QUOTE_SEND_NS_OFFSET = 8;      // int64 quote published (UTC ns)
+static constexpr int QUOTE_TIME_MSC_OFFSET = 16;    // int64 MT5 tick time (ms since epoch)
+static constexpr int QUOTE_BID_OFFSET = 24;         // float64
+static constexpr int QUOTE_ASK_OFFSET = 32;         // float64
+static constexpr int QUOTE_SEQ_OFFSET = 40;         // int64 per-symbol update count
+static constexpr int QUOTE_CONFLATED_OFFSET = 48;   // int32 ticks folded into this quote (1 = none)
+static constexpr int QUOTE_RESERVED_OFFSET = 52;    // int32
+static constexpr int QUOTE_SYMBOL_OFFSET = 56;      // char[32] MT5 symbol
+
+static inline bool isQuoteFrame(const uint8_t* buffer, size_t length)
+{
+    return length >= (size_t)QUOTE_FRAME_SIZE && rd_u32_le(buffer + QUOTE_MAGIC_OFFSET) == QUOTE_MAGIC;
+}
 
 // ===============================
 // Globals
 // ===============================
 static aeron_context_t* g_context = nullptr;
 static aeron_t* g_aeron = nullptr;
-static aeron_async_add_subscription_t* g_asyncSub = nullptr;
 static aeron_subscription_t* g_subscription = nullptr;
+static std::vector<aeron_subscription_t*> g_shardSubscriptions;  // shard streams after the first
+static std::vector<int> g_subStreams;                            // streams StartW subscribed to
+static std::mutex g_subStreamsMutex;                             // guards g_subStreams
 
 static std::atomic<int> g_started{ 0 };
+static std::atomic<int> g_subStreamId{ 0 };
 
-// last error (UTF-8)
+// last text error (UTF-8) - cold paths only (start/stop/config validation)
 static std::mutex  g_errMutex;
 static std::string g_lastError;
+static int64_t     g_lastErrorNs = 0;
 
-// Signal queue (instead of single slot)
-static std::mutex  g_sigMutex;
-static std::queue<std::string> g_signalQueue;
-static constexpr size_t MAX_QUEUE_SIZE = 100;  // Prevent unbounded growth
+// Signal queue: priority lanes by action class, drained highest lane first.
+// Each lane is a fixed ring of preallocated slots (no per-signal allocation).
+static constexpr int SIGNAL_CSV_MAX = 256;
+
+struct QueuedSignal
+{
+    int64_t signalId;    // monotonic, see AeronBridge_LastSignalId
+    int64_t originNs;    // TTL reference (publisher time in local clock, or receive time)
+    int32_t merged;      // source signals netted into this one, see AeronBridge_LastSignalMerged
+    uint64_t enqueueSeq; // global FIFO order across lanes
+    int32_t csvLen;
+    char csv[SIGNAL_CSV_MAX];
+};
+
+enum SignalLaneId
+{
+    LANE_FORCE_EXIT = 0,   // AERON_FORCE_EXIT (10)
+    LANE_RISK = 1,         // exits, stop-loss, profit target (5..9)
+    LANE_ENTRY = 2,        // entries (1..4) and anything else
+    LANE_COUNT
+};
+
+enum LaneDropPolicy
+{
+    DROP_NEWEST = 0,       // reject the incoming signal when full
+    DROP_OLDEST = 1        // evict the oldest queued signal when full
+};
 
-// Instrument mapping + conversion config
-struct InstMap
+struct SignalLane
 {
-    std::string mt5Symbol;   // e.g. "SPX500"
-    double futTickSize;      // e.g. 0.25
-    double mt5PointSize;     // e.g. 0.1 (broker-specific)
+    std::vector<QueuedSignal> slots;  // ring, sized by capacity
+    size_t head;
+    size_t count;
+    int dropPolicy;
+    int64_t enqueued;
+    int64_t delivered;
+    int64_t dropped;
+    int64_t inversionsAvoided;        // dequeued ahead of an older lower-lane signal
+    int64_t expired;                  // TTL expiries (enqueue + dequeue)
+    int64_t hwm;
 };
 
+static std::mutex  g_sigMutex;
+static SignalLane  g_lanes[LANE_COUNT];
+static uint64_t    g_enqueueSeq = 0;  // guarded by g_sigMutex
+static std::atomic<int64_t> g_nextSignalId{ 1 };
+static thread_local int64_t t_lastSignalId = 0;
+static thread_local int32_t t_lastSignalMerged = 0;
+static thread_local int64_t t_enqueuedThisThread = 0;  // PollBudget per-call accounting
+static thread_local int64_t t_droppedThisThread = 0;
+static thread_local bool t_warmupFrame = false;  // synthetic frame in flight, never delivered
+static std::atomic<int> g_warmupFrames{ 0 };     // 0 = warm-up off
+static constexpr size_t MAX_QUEUE_SIZE = 100;  // Prevent unbounded growth (entry lane default)
+
+// Instrument mapping + conversion config (InstMap in AeronBridgeCore.h)
 static std::mutex g_mapMutex;
 static std::unordered_map<std::string, InstMap> g_map;
+static std::vector<std::string> g_registeredPrefixes;  // explicit RegisterInstrumentMapW calls
+static std::atomic<int> g_transformsActive{ 0 };  // any mapping has a non-identity transform
 
 // Unmapped symbol behavior
 static std::atomic<int> g_allowUnmapped{ 0 };
 static double g_defaultTickSize = 0.01;
 static double g_defaultPointSize = 0.01;
 
+// ===============================
+// Error event codes
+// ===============================
+// Hot paths record compact coded events into a lock-free ring; the message
+// text is only formatted when the EA reads them (AeronBridge_GetErrors).
+enum BridgeErrorCode : int32_t
+{
+    ERR_NONE = 0,
+    ERR_TEXT = 1,                // cold-path text error, detail = text id
+    ERR_UNMAPPED_INSTRUMENT = 2, // signal dropped: unknown futures prefix
+    ERR_QUEUE_FULL = 3,          // signal dropped: queue full, detail = capacity
+    ERR_PUB_NOT_CONNECTED = 4,
+    ERR_PUB_BACK_PRESSURED = 5,
+    ERR_PUB_ADMIN_ACTION = 6,
+    ERR_PUB_CLOSED = 7,
+    ERR_PUB_OFFER_FAILED = 8,    // detail = aeron_publication_offer result
+    ERR_RING_OVERFLOW = 9,       // synthetic on drain, detail = events lost
+    ERR_ACK_UNKNOWN_SIGNAL = 10, // PublishAck for an id no longer tracked, detail = id
+    ERR_SOURCE_STALE = 11,       // no heartbeat within the liveness timeout, detail = ms since last
+    ERR_RATE_LIMITED = 12,       // first frame shed for a source/instrument, detail = configured rate/s
+    ERR_QUOTE_TABLE_FULL = 13,   // quote for a new symbol dropped, detail = table size
+    ERR_RATE_TABLE_FULL = 14,    // new key limited by the shared overflow bucket, detail = table size
+    ERR_CODE_COUNT
+};
+
+// Where the event was raised (selects the message prefix)
+enum BridgeErrorOrigin : int32_t
+{
+    ORIGIN_BRIDGE = 0,
+    ORIGIN_SUBSCRIBER = 1,
+    ORIGIN_PUBLISHER = 2,        // legacy single publisher
+    ORIGIN_PUBLISHER_IPC = 3,
+    ORIGIN_PUBLISHER_UDP = 4,
+    ORIGIN_PUBLISHER_ACK = 5,
+    ORIGIN_PUBLISHER_QUOTE = 6
+};
+
+// ===============================
+// Bridge counters
+// ===============================
+// Registered in the Aeron CnC file when a client is up so AeronStat or a
+// sidecar can watch each terminal out of process. Until then (or after the
+// client closes) the same counters live in g_localCounters.
+static constexpr int32_t BRIDGE_COUNTER_TYPE_ID = 1601;  // application range (>= 1000)
+
+enum BridgeCounter
+{
+    CNT_FRAGMENTS_POLLED = 0,
+    CNT_REJECTED_LENGTH,
+    CNT_REJECTED_MAGIC,
+    CNT_REJECTED_VERSION,
+    CNT_EXITS_FILTERED,
+    CNT_UNMAPPED_DROPS,
+    CNT_QUEUE_FULL_DROPS,
+    CNT_SIGNALS_ENQUEUED,
+    CNT_SIGNALS_DELIVERED,
+    CNT_QUEUE_DEPTH_HWM,
+    CNT_PUBLISH_OK,
+    CNT_PUBLISH_FAILED,
+    CNT_PUBLISH_BACK_PRESSURED,
+    CNT_EXPIRED_AT_ENQUEUE,
+    CNT_EXPIRED_AT_DEQUEUE,
+    CNT_CLOCK_SKEW,
+    CNT_IMAGES_JOINED,
+    CNT_IMAGES_LEFT,
+    CNT_IMAGE_LAG_MAX,
+    CNT_POLLS_SATURATED,
+    CNT_SIGNALS_NETTED,
+    CNT_NET_REVERSALS,
+    CNT_CLOCK_CORRECTION_MAX,
+    CNT_HEARTBEATS_SENT,
+    CNT_HEARTBEATS_RECEIVED,
+    CNT_SOURCES_STALE,
+    CNT_SIGNALS_RESTORED,
+    CNT_WARM_RESUMES,
+    CNT_RESUME_GAP_BYTES,
+    CNT_RATE_LIMITED,
+    CNT_TRANSFORMED,
+    CNT_WARMUP_FRAMES,
+    CNT_QUOTES_UPDATED,
+    CNT_QUOTES_SENT,
+    CNT_QUOTES_CONFLATED,
+    CNT_SESSION_GATED,
+    CNT_SESSION_CONVERTED,
+    CNT_STATE_SNAPSHOTS_SENT,
+    CNT_STATE_SEEDED,
+    CNT_FIRST_DECODE_NS,
+    CNT_DECODE_NS_TOTAL,
+    CNT_DECODES,
+    CNT_RATE_OVERFLOW,
+    CNT_COUNT
+};
+
+static const char* const BRIDGE_COUNTER_LABELS[CNT_COUNT] = {
+    "fragments polled",
+    "frames rejected (length)",
+    "frames rejected (magic)",
+    "frames rejected (version)",
+    "exits filtered",
+    "unmapped drops",
+    "queue full drops",
+    "signals enqueued",
+    "signals delivered",
+    "queue depth high-water mark",
+    "publish ok",
+    "publish failed",
+    "publish back pressured",
+    "signals expired at enqueue",
+    "signals expired at dequeue",
+    "frame timestamps beyond skew tolerance",
+    "subscriber images joined",
+    "subscriber images left",
+    "subscriber image lag max bytes",
+    "polls that hit the fragment limit or budget",
+    "signals merged by netting",
+    "netting windows reversed by an opposite entry",
+    "clock re-sync max correction ns",
+    "heartbeats sent",
+    "heartbeats received",
+    "sources gone stale",
+    "signals restored from shared memory",
+    "starts restored from a persisted snapshot",
+    "bytes skipped by images rejoining after a reload",
+    "frames shed by rate limits",
+    "signals altered by mapping transforms",
+    "synthetic warm-up frames",
+    "quote updates from the EA",
+    "quotes published",
+    "quote updates conflated",
+    "entries gated by session calendar",
+    "entries converted to force exit near session close",
+    "state snapshots sent",
+    "state entries seeded from snapshots",
+    "first signal decode ns after start",
+    "steady-state decode ns total",
+    "steady-state signal frames decoded",
+    "frames limited by a rate overflow bucket",
+};
+
+static int64_t g_localCounters[CNT_COUNT];
+static std::atomic<int64_t*> g_counterAddr[CNT_COUNT];   // null = g_localCounters
+static aeron_counter_t* g_counterHandles[CNT_COUNT];
+
+static inline volatile LONG64* counterAddr(int id)
+{
+    int64_t* addr = g_counterAddr[id].load(std::memory_order_acquire);
+    return (volatile LONG64*)(addr ? addr : &g_localCounters[id]);
+}
+
+static inline void counterAdd(int id, int64_t delta)
+{
+    InterlockedExchangeAdd64(counterAddr(id), (LONG64)delta);
+}
+
+static inline void counterSet(int id, int64_t value)
+{
+    InterlockedExchange64(counterAddr(id), (LONG64)value);
+}
+
+static inline void counterMax(int id, int64_t value)
+{
+    volatile LONG64* addr = counterAddr(id);
+    LONG64 cur = *addr;
+    while (value > cur)
+    {
+        const LONG64 prev = InterlockedCompareExchange64(addr, (LONG64)value, cur);
+        if (prev == cur) break;
+        cur = prev;
+    }
+}
+
+// Per publication endpoint: ok / failed / back pressured
+enum EndpointCounter
+{
+    EP_CNT_OK = 0,
+    EP_CNT_FAILED,
+    EP_CNT_BACK_PRESSURED,
+    EP_CNT_COUNT
+};
+
+struct EndpointCounters
+{
+    aeron_counter_t* handles[EP_CNT_COUNT];
+    int64_t* addr[EP_CNT_COUNT];   // null when not registered
+};
+
+static inline void endpointCounterAdd(const EndpointCounters* epc, int id)
+{
+    if (epc && epc->addr[id])
+        InterlockedExchangeAdd64((volatile LONG64*)epc->addr[id], 1);
+}
+
 // ===============================
 // Publisher (Aeron Producer) Globals
 // ===============================
@@ -90,20 +358,35 @@ struct PublisherEndpoint
     std::string channel;
     int streamId;
     aeron_publication_t* publication;
+    EndpointCounters counters;
 };
 
 static std::mutex g_pubMux;
 static std::vector<PublisherEndpoint> g_ipcPublications;
 static std::vector<PublisherEndpoint> g_udpPublications;
 
+// Multi-destination-cast: one UDP publication fans out to many destinations.
+// Manual-mode destinations added at runtime, keyed by publication.
+static std::unordered_map<aeron_publication_t*, std::vector<std::string>> g_mdcDestinations;  // guarded by g_pubMux
+
+// Execution ack back-channel
+static std::vector<PublisherEndpoint> g_ackPublications;  // guarded by g_pubMux
+
+// Market-data quote stream
+static std::vector<PublisherEndpoint> g_quotePublications;  // guarded by g_pubMux
+static aeron_subscription_t* g_ackSubscription = nullptr;
+
 // Forward declarations for helpers used by publisher functions
 static void setError(const std::string& s);
 static void setErrorFromAeron(const char* prefix);
+static void recordError(int32_t code, int32_t origin, int32_t streamId, const char* instrument, int64_t detail);
 
 // Legacy single publisher (kept for backward compatibility)
 static aeron_async_add_publication_t* g_asyncPub = nullptr;
 static aeron_publication_t* g_publication = nullptr;
 static std::atomic<int> g_pubStarted{ 0 };
+static int g_pubStreamId = 0;
+static EndpointCounters g_pubCounters{};
 
 static bool isPublicationRegistered(
     const std::vector<PublisherEndpoint>& publications,
@@ -122,7 +405,9 @@ static int offerToPublication(
     aeron_publication_t* publication,
     const uint8_t* buffer,
     size_t bufferLen,
-    const char* prefix)
+    int32_t origin,
+    int32_t streamId,
+    const EndpointCounters* counters)
 {
     int64_t result = aeron_publication_offer(
         publication,
@@ -132,47 +417,378 @@ static int offerToPublication(
         nullptr);
 
     if (result >= 0)
+    {
+        counterAdd(CNT_PUBLISH_OK, 1);
+        endpointCounterAdd(counters, EP_CNT_OK);
         return 1;
+    }
 
-    std::string ctx = prefix ? std::string(prefix) : std::string("Publication");
-    if (result == AERON_PUBLICATION_NOT_CONNECTED)
+    counterAdd(CNT_PUBLISH_FAILED, 1);
+    endpointCounterAdd(counters, EP_CNT_FAILED);
+    if (result == AERON_PUBLICATION_BACK_PRESSURED)
     {
-        setError(ctx + " not connected");
+        counterAdd(CNT_PUBLISH_BACK_PRESSURED, 1);
+        endpointCounterAdd(counters, EP_CNT_BACK_PRESSURED);
     }
+
+    int32_t code = ERR_PUB_OFFER_FAILED;
+    if (result == AERON_PUBLICATION_NOT_CONNECTED)
+        code = ERR_PUB_NOT_CONNECTED;
     else if (result == AERON_PUBLICATION_BACK_PRESSURED)
-    {
-        setError(ctx + " back pressured");
-    }
+        code = ERR_PUB_BACK_PRESSURED;
     else if (result == AERON_PUBLICATION_ADMIN_ACTION)
-    {
-        setError(ctx + " admin action");
-    }
+        code = ERR_PUB_ADMIN_ACTION;
     else if (result == AERON_PUBLICATION_CLOSED)
+        code = ERR_PUB_CLOSED;
+
+    recordError(code, origin, streamId, nullptr, result);
+    return 0;
+}
+
+// ===============================
+// Helpers
+// ===============================
+static void cleanupAeronContextIfIdle();  // forward declaration
+static void stopQuoteSender();
+static void closeSubscription();
+static void closeSignalSubscriptions();
+
+// ===============================
+// Calibrated UTC clock
+// ===============================
+// steady_clock (QPC on Windows) anchored to system_clock: sub-microsecond
+// resolution, no steps between re-syncs, and the anchor is refreshed every
+// CLOCK_RESYNC_NS so NTP adjustments are followed. Used for every timestamp the
+// DLL writes or compares (frames, acks, TTL, errors).
+static constexpr int64_t CLOCK_RESYNC_NS = 1000000000LL;  // 1 s
+static constexpr int CLOCK_SYNC_SAMPLES = 5;
+
+static inline int64_t steadyNanos()
+{
+    return (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// UTC minus steady. Brackets each system_clock read between two steady reads
+// and keeps the tightest pair, so the anchor error is bounded by that read.
+static int64_t measureClockOffset()
+{
+    int64_t bestSpan = INT64_MAX;
+    int64_t offset = 0;
+    for (int i = 0; i < CLOCK_SYNC_SAMPLES; i++)
     {
-        setError(ctx + " closed");
+        const int64_t before = steadyNanos();
+        const int64_t utc = (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        const int64_t after = steadyNanos();
+        if (after - before < bestSpan)
+        {
+            bestSpan = after - before;
+            offset = utc - (before + (after - before) / 2);
+        }
     }
-    else
+    return offset;
+}
+
+static std::atomic<int64_t> g_clockOffsetNs{ measureClockOffset() };
+static std::atomic<int64_t> g_clockNextSyncNs{ steadyNanos() + CLOCK_RESYNC_NS };
+static thread_local int64_t t_lastNowNs = 0;  // AeronBridge_NowNanos is monotonic per thread
+
+static inline int64_t wallClockNanos()
+{
+    const int64_t steadyNs = steadyNanos();
+    int64_t next = g_clockNextSyncNs.load(std::memory_order_relaxed);
+    if (steadyNs >= next &&
+        g_clockNextSyncNs.compare_exchange_strong(next, steadyNs + CLOCK_RESYNC_NS, std::memory_order_relaxed))
     {
-        setErrorFromAeron((ctx + " offer failed").c_str());
+        const int64_t offset = measureClockOffset();
+        const int64_t correction = offset - g_clockOffsetNs.exchange(offset, std::memory_order_relaxed);
+        counterMax(CNT_CLOCK_CORRECTION_MAX, correction < 0 ? -correction : correction);
     }
+    return steadyNs + g_clockOffsetNs.load(std::memory_order_relaxed);
+}
 
-    return 0;
+// Frames published with a zero timestamp are stamped here, at send time.
+// Returns the frame to offer: buffer itself, or scratch holding the stamped copy.
+static const uint8_t* stampFrameIfUnset(const uint8_t* buffer, uint8_t* scratch)
+{
+    if (rd_i64_le(buffer + TIMESTAMP_OFFSET) != 0) return buffer;
+    std::memcpy(scratch, buffer, FRAME_SIZE);
+    wr_i64_le(scratch + TIMESTAMP_OFFSET, wallClockNanos());
+    return scratch;
 }
 
 // ===============================
-// Helpers
+// Error event ring
 // ===============================
-static void cleanupAeronContextIfIdle();  // forward declaration
+// Bounded MPMC ring (per-slot sequence numbers). Producers never block and
+// never allocate: a full ring drops the event and counts it. The consumer
+// side (GetErrors) is serialized by g_errReadMutex so it can peek before pop.
+struct ErrorEvent
+{
+    int64_t  timestampNs;    // UTC ns
+    int64_t  detail;         // code-specific number
+    int32_t  code;           // BridgeErrorCode
+    int32_t  origin;         // BridgeErrorOrigin
+    int32_t  streamId;
+    uint32_t suppressed;     // same-code events rate-limited before this one
+    char     instrument[32]; // zero-terminated, may be empty
+};
+
+struct ErrorSlot
+{
+    std::atomic<uint64_t> seq;
+    ErrorEvent event;
+};
+
+static constexpr uint64_t ERROR_RING_SIZE = 256;  // power of two
+static constexpr uint64_t ERROR_RING_MASK = ERROR_RING_SIZE - 1;
+
+static ErrorSlot g_errRing[ERROR_RING_SIZE];
+static std::atomic<uint64_t> g_errHead{ 0 };
+static uint64_t g_errTail = 0;                    // guarded by g_errReadMutex
+static std::mutex g_errReadMutex;
+static std::atomic<int64_t> g_errRingDropped{ 0 };
+
+// Per-code rate limiting: at most g_errRateLimit events per code per second.
+// Window and count share one word so a window reset can never lose a count.
+struct ErrorRateState
+{
+    std::atomic<uint64_t> window;      // (UTC second << 32) | events in that second
+    std::atomic<uint32_t> suppressed;
+};
+
+static ErrorRateState g_errRate[ERR_CODE_COUNT];
+static std::atomic<int32_t> g_errRateLimit{ 20 };  // 0 = unlimited
+
+// Most recent coded event, for AeronBridge_LastError (seqlock, writers skip if busy)
+static std::atomic<uint32_t> g_lastEventSeq{ 0 };
+static ErrorEvent g_lastEvent;
+
+// Recent cold-path texts referenced by ERR_TEXT events (guarded by g_errMutex)
+static constexpr int ERROR_TEXT_SLOTS = 16;
+static std::string g_errTexts[ERROR_TEXT_SLOTS];
+static int64_t g_errTextIds[ERROR_TEXT_SLOTS];
+static int64_t g_errTextNextId = 1;
+
+static bool initErrorRing()
+{
+    for (uint64_t i = 0; i < ERROR_RING_SIZE; i++)
+        g_errRing[i].seq.store(i, std::memory_order_relaxed);
+    return true;
+}
+static const bool g_errRingReady = initErrorRing();
+
+static bool allowErrorCode(int32_t code, int64_t nowNs, uint32_t* suppressedOut)
+{
+    *suppressedOut = 0;
+    const int32_t limit = g_errRateLimit.load(std::memory_order_relaxed);
+    // Cold-path text errors (start/config) are never rate limited
+    if (limit <= 0 || code <= ERR_TEXT || code >= ERR_CODE_COUNT) return true;
+
+    ErrorRateState& st = g_errRate[code];
+    const uint64_t second = (uint64_t)(nowNs / 1000000000);
+    uint64_t cur = st.window.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        const uint32_t count = (cur >> 32) == second ? (uint32_t)cur : 0;
+        if (count >= (uint32_t)limit)
+        {
+            st.suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (st.window.compare_exchange_weak(cur, (second << 32) | (count + 1), std::memory_order_relaxed))
+            break;
+    }
+    *suppressedOut = st.suppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+static bool pushErrorEvent(const ErrorEvent& ev)
+{
+    uint64_t pos = g_errHead.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        ErrorSlot& slot = g_errRing[pos & ERROR_RING_MASK];
+        const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        const int64_t diff = (int64_t)seq - (int64_t)pos;
+        if (diff == 0)
+        {
+            if (g_errHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                slot.event = ev;
+                slot.seq.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;  // full
+        }
+        else
+        {
+            pos = g_errHead.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Caller holds g_errReadMutex
+static bool peekErrorEvent(ErrorEvent* out)
+{
+    ErrorSlot& slot = g_errRing[g_errTail & ERROR_RING_MASK];
+    if (slot.seq.load(std::memory_order_acquire) != g_errTail + 1) return false;
+    *out = slot.event;
+    return true;
+}
+
+// Caller holds g_errReadMutex
+static void popErrorEvent()
+{
+    ErrorSlot& slot = g_errRing[g_errTail & ERROR_RING_MASK];
+    slot.seq.store(g_errTail + ERROR_RING_SIZE, std::memory_order_release);
+    g_errTail++;
+}
+
+static void storeLastEvent(const ErrorEvent& ev)
+{
+    uint32_t s = g_lastEventSeq.load(std::memory_order_relaxed);
+    if ((s & 1) != 0) return;  // another writer is publishing a newer event
+    if (!g_lastEventSeq.compare_exchange_strong(s, s + 1, std::memory_order_acquire)) return;
+    std::atomic_thread_fence(std::memory_order_release);
+    g_lastEvent = ev;
+    g_lastEventSeq.store(s + 2, std::memory_order_release);
+}
+
+static bool loadLastEvent(ErrorEvent* out)
+{
+    for (int attempt = 0; attempt < 64; attempt++)
+    {
+        const uint32_t s1 = g_lastEventSeq.load(std::memory_order_acquire);
+        if (s1 == 0) return false;
+        if ((s1 & 1) != 0) continue;
+        *out = g_lastEvent;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (g_lastEventSeq.load(std::memory_order_relaxed) == s1) return true;
+    }
+    return false;
+}
+
+// Hot-path safe: no locks, no allocation, no formatting
+static void recordError(int32_t code, int32_t origin, int32_t streamId, const char* instrument, int64_t detail)
+{
+    const int64_t nowNs = wallClockNanos();
+    uint32_t suppressed = 0;
+    if (!allowErrorCode(code, nowNs, &suppressed)) return;
+
+    ErrorEvent ev;
+    ev.timestampNs = nowNs;
+    ev.detail = detail;
+    ev.code = code;
+    ev.origin = origin;
+    ev.streamId = streamId;
+    ev.suppressed = suppressed;
+    size_t n = 0;
+    if (instrument)
+    {
+        while (n < sizeof(ev.instrument) - 1 && instrument[n] != 0)
+        {
+            ev.instrument[n] = instrument[n];
+            n++;
+        }
+    }
+    ev.instrument[n] = 0;
+
+    storeLastEvent(ev);
+    if (!pushErrorEvent(ev))
+        g_errRingDropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+static const char* errorOriginName(int32_t origin)
+{
+    switch (origin)
+    {
+    case ORIGIN_SUBSCRIBER:     return "Subscription";
+    case ORIGIN_PUBLISHER:      return "Publication";
+    case ORIGIN_PUBLISHER_IPC:  return "IPC Publication";
+    case ORIGIN_PUBLISHER_UDP:  return "UDP Publication";
+    case ORIGIN_PUBLISHER_ACK:  return "Ack Publication";
+    case ORIGIN_PUBLISHER_QUOTE: return "Quote Publication";
+    default:                    return "Bridge";
+    }
+}
 
-static void setErrorLocked(const std::string& s)
+// Lazily renders the message text for an event (read side only)
+static int formatErrorMessage(const ErrorEvent& ev, char* out, size_t outLen)
 {
-    g_lastError = s;
+    const char* origin = errorOriginName(ev.origin);
+    switch (ev.code)
+    {
+    case ERR_TEXT:
+    {
+        std::lock_guard<std::mutex> lock(g_errMutex);
+        const int slot = (int)(ev.detail % ERROR_TEXT_SLOTS);
+        if (g_errTextIds[slot] == ev.detail)
+            return std::snprintf(out, outLen, "%s", g_errTexts[slot].c_str());
+        return std::snprintf(out, outLen, "(error text %lld overwritten)", (long long)ev.detail);
+    }
+    case ERR_UNMAPPED_INSTRUMENT:
+    {
+        int prefixLen = 0;
+        while (ev.instrument[prefixLen] != 0 && ev.instrument[prefixLen] != ' ') prefixLen++;
+        return std::snprintf(out, outLen,
+            "DROPPED SIGNAL: Unknown instrument prefix '%.*s' from instrument '%s'. Register mapping via AeronBridge_RegisterInstrumentMapW() or enable pass-through with AeronBridge_SetUnmappedBehaviorW()",
+            prefixLen, ev.instrument, ev.instrument);
+    }
+    case ERR_QUEUE_FULL:
+        return std::snprintf(out, outLen, "DROPPED SIGNAL: queue full (%lld) for instrument '%s'",
+            (long long)ev.detail, ev.instrument);
+    case ERR_PUB_NOT_CONNECTED:
+        return std::snprintf(out, outLen, "%s streamId=%d not connected", origin, (int)ev.streamId);
+    case ERR_PUB_BACK_PRESSURED:
+        return std::snprintf(out, outLen, "%s streamId=%d back pressured", origin, (int)ev.streamId);
+    case ERR_PUB_ADMIN_ACTION:
+        return std::snprintf(out, outLen, "%s streamId=%d admin action", origin, (int)ev.streamId);
+    case ERR_PUB_CLOSED:
+        return std::snprintf(out, outLen, "%s streamId=%d closed", origin, (int)ev.streamId);
+    case ERR_PUB_OFFER_FAILED:
+        return std::snprintf(out, outLen, "%s streamId=%d offer failed: result=%lld",
+            origin, (int)ev.streamId, (long long)ev.detail);
+    case ERR_RING_OVERFLOW:
+        return std::snprintf(out, outLen, "Error ring overflow: %lld events lost", (long long)ev.detail);
+    case ERR_ACK_UNKNOWN_SIGNAL:
+        return std::snprintf(out, outLen, "PublishAck: signal id %lld is no longer tracked", (long long)ev.detail);
+    case ERR_SOURCE_STALE:
+        return std::snprintf(out, outLen, "SOURCE STALE: no heartbeat from '%s' for %lld ms",
+            ev.instrument, (long long)ev.detail);
+    case ERR_RATE_LIMITED:
+        return std::snprintf(out, outLen, "RATE LIMITED: shedding frames for '%s' above %lld/s (alarm stays set until cleared)",
+            ev.instrument, (long long)ev.detail);
+    case ERR_QUOTE_TABLE_FULL:
+        return std::snprintf(out, outLen, "%s: quote for '%s' dropped, symbol table full (%lld symbols)",
+            origin, ev.instrument, (long long)ev.detail);
+    case ERR_RATE_TABLE_FULL:
+        return std::snprintf(out, outLen, "RATE LIMIT TABLE FULL (%lld buckets): '%s' shares the overflow bucket (alarm stays set until cleared)",
+            (long long)ev.detail, ev.instrument);
+    default:
+        return std::snprintf(out, outLen, "Error code %d", (int)ev.code);
+    }
 }
 
+// Cold paths only (allocates + locks)
 static void setError(const std::string& s)
 {
-    std::lock_guard<std::mutex> lock(g_errMutex);
-    setErrorLocked(s);
+    const int64_t nowNs = wallClockNanos();
+    int64_t textId = 0;
+    {
+        std::lock_guard<std::mutex> lock(g_errMutex);
+        g_lastError = s;
+        g_lastErrorNs = nowNs;
+        textId = g_errTextNextId++;
+        const int slot = (int)(textId % ERROR_TEXT_SLOTS);
+        g_errTexts[slot] = s;
+        g_errTextIds[slot] = textId;
+    }
+    recordError(ERR_TEXT, ORIGIN_BRIDGE, 0, nullptr, textId);
 }
 
 static void setErrorFromAeron(const char* prefix)
@@ -184,52 +800,103 @@ static void setErrorFromAeron(const char* prefix)
     setError(msg);
 }
 
-static inline uint16_t rd_u16_le(const uint8_t* p)
+// Blocking add of one counter (cold path). Key = kind, stream id, process id.
+static aeron_counter_t* addAeronCounter(int32_t kind, int32_t streamId, const char* label)
 {
-    return (uint16_t)(p[0] | (p[1] << 8));
-}
+    if (!g_aeron) return nullptr;
 
-static inline uint32_t rd_u32_le(const uint8_t* p)
-{
-    return (uint32_t)(p[0] | (p[1] << 8) | (p[2] << 16) | (p[3] << 24));
+    uint8_t key[12];
+    wr_u32_le(key, (uint32_t)kind);
+    wr_u32_le(key + 4, (uint32_t)streamId);
+    wr_u32_le(key + 8, (uint32_t)GetCurrentProcessId());
+
+    aeron_async_add_counter_t* async = nullptr;
+    if (aeron_async_add_counter(&async, g_aeron, BRIDGE_COUNTER_TYPE_ID,
+        key, sizeof(key), label, std::strlen(label)) < 0)
+    {
+        return nullptr;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(1000);
+    aeron_counter_t* counter = nullptr;
+    while (true)
+    {
+        const int pollRes = aeron_async_add_counter_poll(&counter, async);
+        if (pollRes < 0) return nullptr;
+        if (pollRes > 0) return counter;
+        if (std::chrono::steady_clock::now() >= deadline) return nullptr;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
 }
 
-static inline int32_t rd_i32_le(const uint8_t* p)
+// Move the bridge-wide counters into the CnC file (values carried over)
+static void registerBridgeCounters()
 {
-    return (int32_t)rd_u32_le(p);
+    if (!g_aeron) return;
+
+    const unsigned pid = (unsigned)GetCurrentProcessId();
+    for (int id = 0; id < CNT_COUNT; id++)
+    {
+        if (g_counterHandles[id]) continue;
+
+        char label[128];
+        std::snprintf(label, sizeof(label), "AeronBridge pid=%u: %s", pid, BRIDGE_COUNTER_LABELS[id]);
+        aeron_counter_t* counter = addAeronCounter(id, 0, label);
+        if (!counter)
+        {
+            setErrorFromAeron("Bridge counters: aeron_async_add_counter failed");
+            return;
+        }
+
+        int64_t* addr = aeron_counter_addr(counter);
+        InterlockedExchange64((volatile LONG64*)addr, (LONG64)g_localCounters[id]);
+        g_counterHandles[id] = counter;
+        g_counterAddr[id].store(addr, std::memory_order_release);
+    }
 }
 
-static inline int64_t rd_i64_le(const uint8_t* p)
+// Copy values back to g_localCounters before the client goes away
+static void releaseBridgeCounters()
 {
-    uint64_t v =
-        (uint64_t)p[0] |
-        ((uint64_t)p[1] << 8) |
-        ((uint64_t)p[2] << 16) |
-        ((uint64_t)p[3] << 24) |
-        ((uint64_t)p[4] << 32) |
-        ((uint64_t)p[5] << 40) |
-        ((uint64_t)p[6] << 48) |
-        ((uint64_t)p[7] << 56);
-    return (int64_t)v;
+    for (int id = 0; id < CNT_COUNT; id++)
+    {
+        int64_t* addr = g_counterAddr[id].exchange(nullptr, std::memory_order_acq_rel);
+        if (addr) g_localCounters[id] = (int64_t)InterlockedExchangeAdd64((volatile LONG64*)addr, 0);
+        if (g_counterHandles[id])
+        {
+            aeron_counter_close(g_counterHandles[id], nullptr, nullptr);
+            g_counterHandles[id] = nullptr;
+        }
+    }
 }
 
-static inline float rd_f32_le(const uint8_t* p)
+static EndpointCounters registerEndpointCounters(const char* kind, int streamId)
 {
-    uint32_t u = rd_u32_le(p);
-    float f;
-    std::memcpy(&f, &u, sizeof(float));
-    return f;
+    static const char* const names[EP_CNT_COUNT] = { "publish ok", "publish failed", "publish back pressured" };
+
+    EndpointCounters epc{};
+    const unsigned pid = (unsigned)GetCurrentProcessId();
+    for (int id = 0; id < EP_CNT_COUNT; id++)
+    {
+        char label[128];
+        std::snprintf(label, sizeof(label), "AeronBridge pid=%u: %s stream=%d %s", pid, kind, streamId, names[id]);
+        epc.handles[id] = addAeronCounter(100 + id, streamId, label);
+        epc.addr[id] = epc.handles[id] ? aeron_counter_addr(epc.handles[id]) : nullptr;
+    }
+    return epc;
 }
 
-static std::string read_ascii_trim0(const uint8_t* p, int len)
+static void closeEndpointCounters(EndpointCounters& epc)
 {
-    int end = 0;
-    for (int i = 0; i < len; i++)
+    for (int id = 0; id < EP_CNT_COUNT; id++)
     {
-        if (p[i] == 0) break;
-        end++;
+        epc.addr[id] = nullptr;
+        if (epc.handles[id])
+        {
+            aeron_counter_close(epc.handles[id], nullptr, nullptr);
+            epc.handles[id] = nullptr;
+        }
     }
-    return std::string((const char*)p, (size_t)end);
 }
 
 static std::string wide_to_utf8(const wchar_t* w)
@@ -247,36 +914,93 @@ static std::string wide_to_utf8(const wchar_t* w)
     return out;
 }
 
-static bool channelLooksValid(const std::string& ch)
+// ===============================
+// Channel tuning
+// ===============================
+// Frames are at most ROUTED_FRAME_SIZE bytes, yet driver defaults size every
+// publication's log buffer for bulk data (3 terms of 16 MiB for UDP, 64 MiB for
+// IPC). The tuned start API appends validated term-length / mtu / sparse /
+// linger / session-id parameters to the channel URI; GetMemoryReport shows what
+// each endpoint actually maps.
+static constexpr int64_t MIN_TERM_LENGTH = 64 * 1024;
+static constexpr int64_t MAX_TERM_LENGTH = 1024 * 1024 * 1024;
+static constexpr int DATA_HEADER_LENGTH = 32;
+static constexpr int MAX_MTU = 65504;
+static constexpr int64_t LOG_META_DATA_BYTES = 4096;  // one page after the 3 terms
+
+struct ChannelTuning
 {
-    // Basic check: must start with "aeron:" like you already want.
-    return ch.rfind("aeron:", 0) == 0;
+    int termLength;  // 0 = driver default
+    int mtu;         // 0 = driver default
+    int sparse;      // -1 = driver default, 0/1
+    int lingerMs;    // -1 = driver default
+    int sessionId;   // 0 = assigned by the driver
+};
+
+static inline int64_t logBufferBytes(int64_t termLength)
+{
+    return termLength > 0 ? termLength * 3 + LOG_META_DATA_BYTES : 0;
 }
 
-static std::string futPrefixFromInstrument(const std::string& instrument)
+// Returns an empty string (and sets *err) if the tuning is invalid for our frames
+static std::string tunedChannel(const std::string& channel, const ChannelTuning& t, std::string* err)
 {
-    // "ES MAR26" -> "ES"
-    // "NQ MAR26" -> "NQ"
-    auto pos = instrument.find(' ');
-    if (pos == std::string::npos) return instrument;
-    return instrument.substr(0, pos);
+    const int64_t term = t.termLength;
+    if (term != 0 && (term < MIN_TERM_LENGTH || term > MAX_TERM_LENGTH || (term & (term - 1)) != 0))
+    {
+        *err = "termLength must be 0 or a power of two between 64 KiB and 1 GiB";
+        return std::string();
+    }
+    if (t.mtu != 0 && (t.mtu < DATA_HEADER_LENGTH + ROUTED_FRAME_SIZE || t.mtu > MAX_MTU || (t.mtu % 32) != 0))
+    {
+        *err = "mtu must be 0 or a multiple of 32 between " +
+            std::to_string(DATA_HEADER_LENGTH + ROUTED_FRAME_SIZE) + " and " + std::to_string(MAX_MTU);
+        return std::string();
+    }
+    if (term != 0 && t.mtu > term)
+    {
+        *err = "mtu must not exceed termLength";
+        return std::string();
+    }
+    if (t.sparse < -1 || t.sparse > 1 || t.lingerMs < -1)
+    {
+        *err = "sparse must be -1, 0 or 1 and lingerMs >= -1";
+        return std::string();
+    }
+
+    std::string params;
+    if (term != 0) params += "|term-length=" + std::to_string(term);
+    if (t.mtu != 0) params += "|mtu=" + std::to_string(t.mtu);
+    if (t.sparse >= 0) params += t.sparse ? "|sparse=true" : "|sparse=false";
+    if (t.lingerMs >= 0) params += "|linger=" + std::to_string((int64_t)t.lingerMs * 1000000) + "ns";
+    if (t.sessionId != 0) params += "|session-id=" + std::to_string(t.sessionId);
+
+    for (const char* key : { "term-length=", "mtu=", "sparse=", "linger=", "session-id=" })
+    {
+        if (params.find(key) != std::string::npos && channel.find(key) != std::string::npos)
+        {
+            *err = std::string("channel already sets ") + key + " (pass 0/-1 to keep it)";
+            return std::string();
+        }
+    }
+
+    if (params.empty()) return channel;
+    params[0] = channel.find('?') == std::string::npos ? '?' : '|';
+    return channel + params;
 }
 
-static int ticksToMt5Points(int ticks, const InstMap& m)
+static bool channelLooksValid(const std::string& ch)
 {
-    // priceMove = ticks * futTickSize
-    // mt5Points = priceMove / mt5PointSize
-    if (ticks <= 0) return 0;
-    if (m.futTickSize <= 0.0 || m.mt5PointSize <= 0.0) return 0;
-    double priceMove = (double)ticks * m.futTickSize;
-    double pts = priceMove / m.mt5PointSize;
-    // round to nearest int (safer than trunc)
-    if (pts < 0) pts = 0;
-    return (int)(pts + 0.5);
+    // Basic check: must start with "aeron:" like you already want.
+    return ch.rfind("aeron:", 0) == 0;
 }
 
+// Mappings are never removed, so the defaults only need seeding once
+static std::atomic<int> g_defaultMapSeeded{ 0 };
+
 static void ensureDefaultMap()
 {
+    if (g_defaultMapSeeded.load(std::memory_order_acquire)) return;
     std::lock_guard<std::mutex> lock(g_mapMutex);
 
     // ==================================================================================
@@ -348,671 +1072,5038 @@ static void ensureDefaultMap()
     // Example: 14 ticks → (14 × 0.005) ÷ 0.01 = 70 MT5 points = 0.070 price units
     if (g_map.find("SI") == g_map.end())
         g_map["SI"] = InstMap{ "XAGUSD", 0.005, 0.01 };
+
+    g_defaultMapSeeded.store(1, std::memory_order_release);
+}
+
+// Mapping key for an instrument ("ES MAR26" -> "ES"). The per-thread key is
+// reused, so steady-state lookups do not allocate.
+static const std::string& mapKeyForInstrument(const char* instrument)
+{
+    static thread_local std::string key;
+    key.assign(instrument, futPrefixLength(instrument));
+    return key;
 }
 
 // ===============================
-// Fragment handler
+// Stream sharding
 // ===============================
-static void onFragment(
-    void* /*clientd*/,
-    const uint8_t* buffer,
-    size_t length,
-    aeron_header_t* /*header*/)
+// Optional futures prefix -> stream map, set with the same string on publisher
+// and subscriber terminals. Publishers offer each signal frame only to the
+// endpoints on its shard's stream; StartW subscribes only to the streams that
+// cover this terminal's mappings, so it never receives or decodes instruments
+// it does not trade. A prefix with no route goes to the "*" stream, or without
+// one to the endpoints (and StartW stream) that are not shard streams.
+static constexpr int MAX_SHARD_ROUTES = 64;
+static constexpr int MAX_SHARD_STREAMS = 16;
+
+struct ShardRoute
 {
-    if (!buffer || length < (size_t)FRAME_SIZE) return;
+    char prefix[INSTRUMENT_LEN + 1];
+    size_t prefixLen;
+    int streamId;
+};
 
-    // Validate MAGIC + VERSION
-    const uint32_t magic = rd_u32_le(buffer + MAGIC_OFFSET);
-    if (magic != MAGIC) return;
+// Compiled map, immutable once published. Publish paths read it lock-free
+// through g_shardMap; SetShardMapW swaps in a new one and keeps the old ones
+// alive (a handful per process) so a reader never sees freed memory.
+struct ShardMap
+{
+    ShardRoute routes[MAX_SHARD_ROUTES];
+    int routeCount;
+    int defaultStream;  // "*" route, 0 = none
+};
 
-    const uint16_t ver = rd_u16_le(buffer + VERSION_OFFSET);
-    if (ver != VERSION) return;
+static std::mutex g_shardMutex;                               // serialises SetShardMapW
+static std::atomic<const ShardMap*> g_shardMap{ nullptr };    // null = sharding off
+static std::vector<std::unique_ptr<ShardMap>> g_shardMaps;    // every map published; guarded by g_shardMutex
 
-    const uint16_t action = rd_u16_le(buffer + ACTION_OFFSET);
+// 0 if the prefix has no route of its own
+static int shardRoute(const ShardMap& map, const char* prefix, size_t len)
+{
+    for (int i = 0; i < map.routeCount; i++)
+    {
+        const ShardRoute& r = map.routes[i];
+        if (r.prefixLen == len && std::memcmp(r.prefix, prefix, len) == 0)
+            return r.streamId;
+    }
+    return 0;
+}
 
-    // Ignore exits as per your requirement (5,6)
-    if (action == 5 || action == 6) return;
+static bool isShardStream(const ShardMap& map, int streamId)
+{
+    if (streamId == map.defaultStream) return true;
+    for (int i = 0; i < map.routeCount; i++)
+    {
+        if (map.routes[i].streamId == streamId) return true;
+    }
+    return false;
+}
 
-    const int32_t longSL = rd_i32_le(buffer + LONG_SL_OFFSET);
-    const int32_t shortSL = rd_i32_le(buffer + SHORT_SL_OFFSET);
-    const int32_t pt = rd_i32_le(buffer + PROFIT_TARGET_OFFSET);
-    const int32_t qty = rd_i32_le(buffer + QTY_OFFSET);
-    const float confidence = rd_f32_le(buffer + CONFIDENCE_OFFSET);
+// Whether an endpoint on streamId carries a frame for the NUL-padded instrument
+// field. Always true while sharding is off.
+static bool shardCarries(int streamId, const uint8_t* instrument)
+{
+    const ShardMap* map = g_shardMap.load(std::memory_order_acquire);
+    if (!map) return true;
 
-    const std::string sym = read_ascii_trim0(buffer + SYMBOL_OFFSET, SYMBOL_LEN);
-    const std::string inst = read_ascii_trim0(buffer + INSTRUMENT_OFFSET, INSTRUMENT_LEN);
-    const std::string src = read_ascii_trim0(buffer + SOURCE_OFFSET, SOURCE_LEN);
+    size_t len = 0;
+    while (len < (size_t)INSTRUMENT_LEN && instrument[len] && instrument[len] != ' ') len++;
 
-    // Determine relevant SL based on direction:
-    // action 1/2 = long entries => use longSL
-    // action 3/4 = short entries => use shortSL
-    int slTicks = 0;
-    if (action == 1 || action == 2) slTicks = longSL;
-    else if (action == 3 || action == 4) slTicks = shortSL;
+    int shard = shardRoute(*map, (const char*)instrument, len);
+    if (shard == 0) shard = map->defaultStream;
+    return shard != 0 ? streamId == shard : !isShardStream(*map, streamId);
+}
 
-    ensureDefaultMap();
+static void addStreamOnce(std::vector<int>& streams, int streamId)
+{
+    if (std::find(streams.begin(), streams.end(), streamId) == streams.end())
+        streams.push_back(streamId);
+}
 
-    const std::string prefix = futPrefixFromInstrument(inst);
+// Streams StartW subscribes to for baseStreamId: the shard of every registered
+// mapping (every mapping if none were registered), plus all shards when
+// unmapped pass-through is on. Cold path.
+static std::vector<int> subscribedStreams(int baseStreamId)
+{
+    const ShardMap* map = g_shardMap.load(std::memory_order_acquire);
+    if (!map) return std::vector<int>{ baseStreamId };
 
-    InstMap map;
-    bool isMapped = false;
+    std::vector<std::string> prefixes;
     {
         std::lock_guard<std::mutex> lock(g_mapMutex);
-        auto it = g_map.find(prefix);
-        if (it == g_map.end())
+        prefixes = g_registeredPrefixes;
+        if (prefixes.empty())
         {
-            // Unknown instrument prefix
-            if (g_allowUnmapped.load())
+            for (const auto& kv : g_map) prefixes.push_back(kv.first);
+        }
+    }
+
+    std::vector<int> streams;
+    const int fallback = map->defaultStream != 0 ? map->defaultStream : baseStreamId;
+    for (const auto& prefix : prefixes)
+    {
+        const int shard = shardRoute(*map, prefix.c_str(), prefix.size());
+        addStreamOnce(streams, shard != 0 ? shard : fallback);
+    }
+    if (g_allowUnmapped.load())
+    {
+        for (int i = 0; i < map->routeCount; i++) addStreamOnce(streams, map->routes[i].streamId);
+        addStreamOnce(streams, fallback);
+    }
+    if (streams.empty()) streams.push_back(fallback);
+    return streams;
+}
+
+// Shard streams a publisher start adds next to its own stream
+static std::vector<int> shardStreams()
+{
+    std::vector<int> streams;
+    const ShardMap* map = g_shardMap.load(std::memory_order_acquire);
+    if (!map) return streams;
+    for (int i = 0; i < map->routeCount; i++) addStreamOnce(streams, map->routes[i].streamId);
+    if (map->defaultStream != 0) addStreamOnce(streams, map->defaultStream);
+    return streams;
+}
+
+// "ES=1101,MES=1101,NQ=1102,*=1100" -> routes. Empty turns sharding off.
+static bool compileShardMap(const std::string& spec, ShardRoute* routes, int* count, int* defaultStream, std::string* err)
+{
+    *count = 0;
+    *defaultStream = 0;
+    std::vector<int> streams;
+    size_t pos = 0;
+    while (pos < spec.size())
+    {
+        size_t end = spec.find(',', pos);
+        if (end == std::string::npos) end = spec.size();
+        std::string item = spec.substr(pos, end - pos);
+        pos = end + 1;
+
+        const size_t b = item.find_first_not_of(" \t");
+        if (b == std::string::npos) continue;
+        item = item.substr(b, item.find_last_not_of(" \t") - b + 1);
+
+        const size_t eq = item.find('=');
+        std::string prefix = eq == std::string::npos ? std::string() : item.substr(0, eq);
+        while (!prefix.empty() && (prefix.back() == ' ' || prefix.back() == '\t')) prefix.pop_back();
+        int streamId = 0;
+        size_t digits = 0;
+        for (size_t i = eq == std::string::npos ? item.size() : eq + 1; i < item.size(); i++)
+        {
+            if ((item[i] == ' ' || item[i] == '\t') && digits == 0) continue;
+            if (item[i] < '0' || item[i] > '9' || ++digits > 9) { streamId = 0; break; }
+            streamId = streamId * 10 + (item[i] - '0');
+        }
+        if (prefix.empty() || prefix.size() > (size_t)INSTRUMENT_LEN || prefix.find(' ') != std::string::npos || streamId <= 0)
+        {
+            *err = "bad entry '" + item + "' (expected PREFIX=streamId)";
+            return false;
+        }
+
+        addStreamOnce(streams, streamId);
+        if ((int)streams.size() > MAX_SHARD_STREAMS)
+        {
+            *err = "more than " + std::to_string(MAX_SHARD_STREAMS) + " shard streams";
+            return false;
+        }
+        if (prefix == "*")
+        {
+            *defaultStream = streamId;
+            continue;
+        }
+        if (*count >= MAX_SHARD_ROUTES)
+        {
+            *err = "more than " + std::to_string(MAX_SHARD_ROUTES) + " prefixes";
+            return false;
+        }
+        ShardRoute& r = routes[(*count)++];
+        std::snprintf(r.prefix, sizeof(r.prefix), "%s", prefix.c_str());
+        r.prefixLen = std::strlen(r.prefix);
+        r.streamId = streamId;
+    }
+    return true;
+}
+
+// ===============================
+// Signal lanes
+// ===============================
+static const char* const LANE_NAMES[LANE_COUNT] = { "force_exit", "risk", "entry" };
+
+static int laneForAction(uint16_t action)
+{
+    if (action == 10) return LANE_FORCE_EXIT;
+    if (action >= 5 && action <= 9) return LANE_RISK;
+    return LANE_ENTRY;
+}
+
+// Caller holds g_sigMutex (or runs before any poll)
+static void resizeLane(SignalLane& lane, size_t capacity, int dropPolicy)
+{
+    lane.slots.assign(capacity, QueuedSignal{});
+    lane.head = 0;
+    lane.count = 0;
+    lane.dropPolicy = dropPolicy;
+}
+
+static bool initSignalLanes()
+{
+    resizeLane(g_lanes[LANE_FORCE_EXIT], 32, DROP_OLDEST);
+    resizeLane(g_lanes[LANE_RISK], 64, DROP_OLDEST);
+    resizeLane(g_lanes[LANE_ENTRY], MAX_QUEUE_SIZE, DROP_NEWEST);
+    return true;
+}
+static const bool g_lanesReady = initSignalLanes();
+
+// Time-to-live per lane, checked against the frame timestamp at enqueue and
+// again at dequeue. The publisher clock is corrected by a configurable offset;
+// timestamps further in the future than the tolerance (skewed clock, zero or
+// garbage values) fall back to the local receive time.
+static std::atomic<int64_t> g_laneTtlNs[LANE_COUNT];          // 0 = never expire
+static std::atomic<int64_t> g_publisherClockOffsetNs{ 0 };    // added to frame timestamps
+static std::atomic<int64_t> g_maxFutureSkewNs{ 1000000000 };  // 1s
+
+static int64_t signalOriginNs(int64_t publishNs, int64_t receiveNs)
+{
+    if (publishNs <= 0) return receiveNs;
+    const int64_t adjusted = publishNs + g_publisherClockOffsetNs.load(std::memory_order_relaxed);
+    if (adjusted - receiveNs > g_maxFutureSkewNs.load(std::memory_order_relaxed))
+    {
+        counterAdd(CNT_CLOCK_SKEW, 1);
+        return receiveNs;
+    }
+    return adjusted;
+}
+
+static inline bool isSignalExpired(int laneId, int64_t originNs, int64_t nowNs)
+{
+    const int64_t ttl = g_laneTtlNs[laneId].load(std::memory_order_relaxed);
+    return ttl > 0 && nowNs - originNs > ttl;
+}
+
+// Caller holds g_sigMutex
+static size_t totalQueuedLocked()
+{
+    size_t n = 0;
+    for (int i = 0; i < LANE_COUNT; i++) n += g_lanes[i].count;
+    return n;
+}
+
+enum EnqueueResult
+{
+    ENQ_OK = 0,
+    ENQ_EVICTED_OLDEST = 1,  // queued, but the lane's oldest signal was dropped
+    ENQ_REJECTED = 2         // lane full, incoming signal dropped
+};
+
+// Caller holds g_sigMutex
+static int enqueueSignalLocked(int laneId, int64_t signalId, int64_t originNs, int32_t merged, const char* csv, int csvLen)
+{
+    SignalLane& lane = g_lanes[laneId];
+    const size_t capacity = lane.slots.size();
+    int result = ENQ_OK;
+
+    if (capacity == 0) return ENQ_REJECTED;
+    if (lane.count >= capacity)
+    {
+        lane.dropped++;
+        if (lane.dropPolicy != DROP_OLDEST) return ENQ_REJECTED;
+        lane.head = (lane.head + 1) % capacity;
+        lane.count--;
+        result = ENQ_EVICTED_OLDEST;
+    }
+
+    QueuedSignal& slot = lane.slots[(lane.head + lane.count) % capacity];
+    if (csvLen < 0) csvLen = 0;
+    if (csvLen >= SIGNAL_CSV_MAX) csvLen = SIGNAL_CSV_MAX - 1;
+    std::memcpy(slot.csv, csv, (size_t)csvLen);
+    slot.csv[csvLen] = 0;
+    slot.csvLen = csvLen;
+    slot.signalId = signalId;
+    slot.originNs = originNs;
+    slot.merged = merged;
+    slot.enqueueSeq = ++g_enqueueSeq;
+
+    lane.count++;
+    lane.enqueued++;
+    if ((int64_t)lane.count > lane.hwm) lane.hwm = (int64_t)lane.count;
+    return result;
+}
+
+// Caller holds g_sigMutex. Warm-up: write the slot the next signal would take
+// without committing it; count is unchanged, so nothing becomes visible.
+static void warmLaneSlotLocked(int laneId, const char* csv, int csvLen)
+{
+    SignalLane& lane = g_lanes[laneId];
+    const size_t capacity = lane.slots.size();
+    if (capacity == 0 || lane.count >= capacity) return;
+
+    QueuedSignal& slot = lane.slots[(lane.head + lane.count) % capacity];
+    if (csvLen < 0) csvLen = 0;
+    if (csvLen >= SIGNAL_CSV_MAX) csvLen = SIGNAL_CSV_MAX - 1;
+    std::memcpy(slot.csv, csv, (size_t)csvLen);
+    slot.csv[csvLen] = 0;
+    slot.csvLen = csvLen;
+}
+
+static void flushDueNettingLocked(int64_t nowNs, bool all);
+static int g_netActive = 0;  // pending netting entries, guarded by g_sigMutex
+
+// Caller holds g_sigMutex. Returns the head slot of the highest non-empty lane,
+// discarding signals whose TTL ran out while they were queued. Netting windows
+// that have closed are released into their lanes first.
+static QueuedSignal* peekSignalLocked(int* laneOut)
+{
+    int64_t nowNs = 0;
+    if (g_netActive > 0)
+    {
+        nowNs = wallClockNanos();
+        flushDueNettingLocked(nowNs, false);
+    }
+    for (int i = 0; i < LANE_COUNT; i++)
+    {
+        SignalLane& lane = g_lanes[i];
+        const bool ttl = g_laneTtlNs[i].load(std::memory_order_relaxed) > 0;
+        while (lane.count > 0)
+        {
+            QueuedSignal& head = lane.slots[lane.head];
+            if (ttl)
             {
-                // Pass-through mode: use prefix as symbol with default conversion
-                map.mt5Symbol = prefix;
-                map.futTickSize = g_defaultTickSize;
-                map.mt5PointSize = g_defaultPointSize;
-                isMapped = false;  // Mark as unmapped for logging
+                if (nowNs == 0) nowNs = wallClockNanos();
+                if (isSignalExpired(i, head.originNs, nowNs))
+                {
+                    lane.head = (lane.head + 1) % lane.slots.size();
+                    lane.count--;
+                    lane.expired++;
+                    counterAdd(CNT_EXPIRED_AT_DEQUEUE, 1);
+                    continue;
+                }
             }
-            else
+            *laneOut = i;
+            return &head;
+        }
+    }
+    return nullptr;
+}
+
+// Caller holds g_sigMutex
+static void popSignalLocked(int laneId)
+{
+    SignalLane& lane = g_lanes[laneId];
+    const uint64_t seq = lane.slots[lane.head].enqueueSeq;
+
+    // Would plain FIFO have delivered an older, lower-priority signal first?
+    for (int i = laneId + 1; i < LANE_COUNT; i++)
+    {
+        const SignalLane& lower = g_lanes[i];
+        if (lower.count > 0 && lower.slots[lower.head].enqueueSeq < seq)
+        {
+            lane.inversionsAvoided++;
+            break;
+        }
+    }
+
+    lane.head = (lane.head + 1) % lane.slots.size();
+    lane.count--;
+    lane.delivered++;
+}
+
+// ===============================
+// Broadcast signal ring
+// ===============================
+// Every mapped signal is written once into a fixed ring; each registered
+// consumer (EA) reads with its own cursor, so several strategies share one
+// decoded feed. Writers are serialized by g_sigMutex; readers are lock-free and
+// validate each slot with its sequence (seqlock). A consumer that falls more
+// than a ring behind is lapped per its policy instead of blocking the writer.
+static constexpr int64_t BCAST_RING_SIZE = 1024;  // power of two
+static constexpr int64_t BCAST_RING_MASK = BCAST_RING_SIZE - 1;
+static constexpr int MAX_BCAST_CONSUMERS = 16;
+static constexpr int CONSUMER_NAME_LEN = 32;
+
+enum LapPolicy
+{
+    LAP_OLDEST = 0,  // lapped consumer resumes at the oldest signal still in the ring
+    LAP_NEWEST = 1   // lapped consumer skips the backlog and resumes at the newest
+};
+
+struct BroadcastSlot
+{
+    std::atomic<int64_t> seq;  // sequence held by the slot, -1 while being written
+    int64_t signalId;
+    int64_t originNs;          // for the lane TTL, checked at read time
+    int32_t lane;
+    int32_t merged;
+    int32_t csvLen;
+    char csv[SIGNAL_CSV_MAX];
+};
+
+struct BroadcastConsumer
+{
+    std::atomic<int> active;
+    char name[CONSUMER_NAME_LEN];
+    int lapPolicy;
+    std::atomic<int64_t> cursor;     // next sequence to read
+    std::atomic<int64_t> delivered;
+    std::atomic<int64_t> lapped;     // signals skipped because the writer lapped us
+    std::atomic<int64_t> lapEvents;
+    std::atomic<int64_t> expired;    // signals skipped because their lane TTL ran out
+};
+
+static BroadcastSlot g_bcast[BCAST_RING_SIZE];
+static std::atomic<int64_t> g_bcastNext{ 0 };  // next sequence to write
+static BroadcastConsumer g_consumers[MAX_BCAST_CONSUMERS];
+static std::atomic<int> g_bcastConsumerCount{ 0 };
+static std::mutex g_consumerMutex;  // register/unregister only
+
+static bool initBroadcastRing()
+{
+    for (auto& slot : g_bcast) slot.seq.store(-1);
+    return true;
+}
+static const bool g_bcastReady = initBroadcastRing();
+
+// Caller holds g_sigMutex (single writer at a time)
+static void broadcastSignalLocked(
+    int laneId, int64_t signalId, int64_t originNs, int32_t merged, const char* csv, int csvLen)
+{
+    if (g_bcastConsumerCount.load(std::memory_order_relaxed) == 0) return;
+
+    const int64_t seq = g_bcastNext.load(std::memory_order_relaxed);
+    BroadcastSlot& slot = g_bcast[seq & BCAST_RING_MASK];
+    slot.seq.store(-1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.signalId = signalId;
+    slot.originNs = originNs;
+    slot.lane = laneId;
+    slot.merged = merged;
+    slot.csvLen = csvLen;
+    std::memcpy(slot.csv, csv, (size_t)csvLen);
+    slot.seq.store(seq, std::memory_order_release);
+    g_bcastNext.store(seq + 1, std::memory_order_release);
+}
+
+// Copies the consumer's next live signal; returns its length, 0 if none.
+// Signals past their lane TTL are skipped, as GetSignalCsv drops them.
+static int readBroadcast(BroadcastConsumer& c, char* out, int outLen, int64_t* signalId, int32_t* merged)
+{
+    int64_t nowNs = 0;
+    for (int attempt = 0; attempt < 64;)
+    {
+        int64_t cursor = c.cursor.load(std::memory_order_relaxed);
+        const int64_t head = g_bcastNext.load(std::memory_order_acquire);
+        if (cursor >= head) return 0;
+
+        if (head - cursor > BCAST_RING_SIZE)
+        {
+            const int64_t resume = c.lapPolicy == LAP_NEWEST ? head - 1 : head - BCAST_RING_SIZE;
+            c.lapped.fetch_add(resume - cursor, std::memory_order_relaxed);
+            c.lapEvents.fetch_add(1, std::memory_order_relaxed);
+            cursor = resume;
+        }
+
+        const BroadcastSlot& slot = g_bcast[cursor & BCAST_RING_MASK];
+        if (slot.seq.load(std::memory_order_acquire) != cursor)
+        {
+            c.cursor.store(cursor, std::memory_order_relaxed);
+            attempt++;
+            continue;  // overwritten (or being written) since we looked at head
+        }
+        const int n = slot.csvLen < outLen ? slot.csvLen : outLen;
+        std::memcpy(out, slot.csv, (size_t)n);
+        *signalId = slot.signalId;
+        *merged = slot.merged;
+        const int lane = slot.lane;
+        const int64_t originNs = slot.originNs;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != cursor)
+        {
+            c.cursor.store(cursor, std::memory_order_relaxed);
+            attempt++;
+            continue;
+        }
+
+        c.cursor.store(cursor + 1, std::memory_order_relaxed);
+        if (g_laneTtlNs[lane].load(std::memory_order_relaxed) > 0)
+        {
+            if (nowNs == 0) nowNs = wallClockNanos();
+            if (isSignalExpired(lane, originNs, nowNs))
             {
-                // Strict mode: reject unknown instruments
-                std::string msg = "DROPPED SIGNAL: Unknown instrument prefix '" + prefix + "' from instrument '" + inst + "'. Register mapping via AeronBridge_RegisterInstrumentMapW() or enable pass-through with AeronBridge_SetUnmappedBehaviorW()";
-                setError(msg);
-                return;
+                c.expired.fetch_add(1, std::memory_order_relaxed);
+                counterAdd(CNT_EXPIRED_AT_DEQUEUE, 1);
+                continue;
             }
         }
-        else
+        c.delivered.fetch_add(1, std::memory_order_relaxed);
+        return n;
+    }
+    return 0;
+}
+
+// ===============================
+// Signal stage tracing
+// ===============================
+// Optional per-signal timeline: each signal id owns a slot (id % capacity) in a
+// buffer preallocated by AeronBridge_SetTracing. Stages are stamped with
+// wallClockNanos, the same calibrated clock as TTLs and the publisher timestamp.
+enum TraceStage
+{
+    TRACE_STAGE_RECEIVE = 0,   // onFragment entry
+    TRACE_STAGE_MAPPED = 1,    // decoded + mapped + tick converted
+    TRACE_STAGE_ENQUEUED = 2,  // pushed to a signal lane
+    TRACE_STAGE_DEQUEUED = 3,  // returned by AeronBridge_GetSignalCsv
+    TRACE_STAGE_EA_FIRST = 4,  // 4..7 reported by the EA via AeronBridge_MarkSignal
+    TRACE_STAGE_COUNT = 8
+};
+
+struct TraceRecord
+{
+    std::atomic<int64_t> signalId;
+    std::atomic<int64_t> publishNs;               // frame timestamp (publisher clock)
+    std::atomic<int64_t> stageNs[TRACE_STAGE_COUNT];
+    uint16_t action;
+    char instrument[32];
+};
+
+// Immutable once published: records and capacity are always read together
+struct TraceBuffer
+{
+    int64_t capacity;
+    std::unique_ptr<TraceRecord[]> records;
+};
+
+static std::atomic<int> g_traceEnabled{ 0 };
+static std::atomic<TraceBuffer*> g_traceBuffer{ nullptr };
+static std::mutex g_traceMutex;  // SetTracing / DumpTrace only
+static std::vector<std::unique_ptr<TraceBuffer>> g_traceBuffers;  // kept alive: poll may still hold an old pointer
+
+static inline TraceRecord* traceSlot(int64_t signalId)
+{
+    TraceBuffer* buffer = g_traceBuffer.load(std::memory_order_acquire);
+    if (!buffer || signalId <= 0) return nullptr;
+    return &buffer->records[signalId % buffer->capacity];
+}
+
+static void traceBegin(int64_t signalId, int64_t receiveNs, int64_t publishNs, uint16_t action, const char* inst)
+{
+    TraceRecord* rec = traceSlot(signalId);
+    if (!rec) return;
+
+    rec->signalId.store(0, std::memory_order_relaxed);  // invalidate while rewriting
+    for (int i = 0; i < TRACE_STAGE_COUNT; i++)
+        rec->stageNs[i].store(0, std::memory_order_relaxed);
+    rec->publishNs.store(publishNs, std::memory_order_relaxed);
+    rec->action = action;
+    std::snprintf(rec->instrument, sizeof(rec->instrument), "%s", inst);
+    rec->stageNs[TRACE_STAGE_RECEIVE].store(receiveNs, std::memory_order_relaxed);
+    rec->signalId.store(signalId, std::memory_order_release);
+}
+
+static void traceStage(int64_t signalId, int stage)
+{
+    TraceRecord* rec = traceSlot(signalId);
+    if (!rec || rec->signalId.load(std::memory_order_acquire) != signalId) return;
+    rec->stageNs[stage].store(wallClockNanos(), std::memory_order_relaxed);
+}
+
+static const char* traceStageName(int stage)
+{
+    switch (stage)
+    {
+    case TRACE_STAGE_RECEIVE:  return "decode_map";
+    case TRACE_STAGE_MAPPED:   return "enqueue";
+    case TRACE_STAGE_ENQUEUED: return "queue_wait";
+    default:                   return "ea_stage";
+    }
+}
+
+// ===============================
+// Ack correlation state
+// ===============================
+// Subscriber side: recently delivered signals by id, so AeronBridge_PublishAck
+// only needs the id the EA got from AeronBridge_LastSignalId.
+struct DeliveredSignal
+{
+    std::atomic<int64_t> signalId;
+    std::atomic<int64_t> publishNs;   // frame timestamp
+    std::atomic<int64_t> receiveNs;   // UTC ns at onFragment
+};
+
+static constexpr int64_t DELIVERED_RING_SIZE = 1024;
+static DeliveredSignal g_delivered[DELIVERED_RING_SIZE];
+
+static void rememberDelivered(int64_t signalId, int64_t publishNs, int64_t receiveNs)
+{
+    DeliveredSignal& d = g_delivered[signalId % DELIVERED_RING_SIZE];
+    d.signalId.store(0, std::memory_order_relaxed);
+    d.publishNs.store(publishNs, std::memory_order_relaxed);
+    d.receiveNs.store(receiveNs, std::memory_order_relaxed);
+    d.signalId.store(signalId, std::memory_order_release);
+}
+
+static bool lookupDelivered(int64_t signalId, int64_t* publishNs, int64_t* receiveNs)
+{
+    if (signalId <= 0) return false;
+    DeliveredSignal& d = g_delivered[signalId % DELIVERED_RING_SIZE];
+    if (d.signalId.load(std::memory_order_acquire) != signalId) return false;
+    *publishNs = d.publishNs.load(std::memory_order_relaxed);
+    *receiveNs = d.receiveNs.load(std::memory_order_relaxed);
+    return d.signalId.load(std::memory_order_acquire) == signalId;
+}
+
+// Publisher side: local send time per published frame timestamp, matched
+// against incoming acks for a same-clock round trip.
+struct SentSignal
+{
+    std::atomic<int64_t> publishNs;
+    std::atomic<int64_t> sentNs;
+};
+
+static constexpr int SENT_RING_BITS = 12;
+static constexpr uint64_t SENT_RING_SIZE = 1ull << SENT_RING_BITS;
+static SentSignal g_sent[SENT_RING_SIZE];
+
+static inline SentSignal& sentSlot(int64_t publishNs)
+{
+    // MQL timestamps are often whole milliseconds - mix before indexing
+    const uint64_t h = (uint64_t)publishNs * 0x9E3779B97F4A7C15ull;
+    return g_sent[h >> (64 - SENT_RING_BITS)];
+}
+
+static void rememberSent(const uint8_t* frame)
+{
+    const int64_t publishNs = rd_i64_le(frame + TIMESTAMP_OFFSET);
+    SentSignal& slot = sentSlot(publishNs);
+    if (slot.publishNs.load(std::memory_order_relaxed) == publishNs) return;  // IPC+UDP: keep first send
+    slot.publishNs.store(0, std::memory_order_relaxed);
+    slot.sentNs.store(wallClockNanos(), std::memory_order_relaxed);
+    slot.publishNs.store(publishNs, std::memory_order_release);
+}
+
+// Per-terminal round-trip statistics (ack poll thread, read by GetAckStats)
+struct TerminalAckStats
+{
+    char terminalId[TERMINAL_ID_LEN + 1];
+    int64_t acks;
+    int64_t ok;
+    int64_t failed;
+    int64_t unmatched;       // no local send time for the signal timestamp
+    int64_t lastRttNs;
+    int64_t minRttNs;
+    int64_t maxRttNs;
+    int64_t sumRttNs;
+    int64_t sumTerminalNs;   // ackNs - receiveNs (terminal-local clock)
+};
+
+static constexpr int MAX_ACK_TERMINALS = 64;
+static std::mutex g_ackMutex;
+static TerminalAckStats g_ackStats[MAX_ACK_TERMINALS];
+static int g_ackStatsCount = 0;
+static char g_terminalId[TERMINAL_ID_LEN + 1] = "";
+
+static bool isTradeRetcodeSuccess(int32_t retcode)
+{
+    // TRADE_RETCODE_PLACED / DONE / DONE_PARTIAL
+    return retcode == 10008 || retcode == 10009 || retcode == 10010;
+}
+
+// ===============================
+// Subscriber image tracking
+// ===============================
+// One record per publisher image (session) on the signal subscription. Lag is
+// the publisher side position (receiver high-water mark for UDP, publisher
+// position for IPC) minus our subscriber position, read from driver counters.
+
+// Stream position counter type ids (aeron_counters.h). Key: registration_id
+// int64, session_id int32, stream_id int32.
+static constexpr int32_t AERON_RECEIVER_HWM_TYPE_ID = 3;
+static constexpr int32_t AERON_PUBLISHER_POSITION_TYPE_ID = 12;
+static constexpr int MAX_IMAGE_RECORDS = 64;
+static constexpr int IMAGE_SOURCE_LEN = 64;
+
+struct ImageRecord
+{
+    int32_t sessionId;
+    int64_t correlationId;
+    char source[IMAGE_SOURCE_LEN];
+    int64_t joinNs;
+    int64_t leaveNs;            // 0 while active
+    int64_t joinPosition;
+    int32_t subscriberPositionId;
+    int32_t publisherPositionId; // -1 if not found
+    int64_t lastPosition;
+    int64_t lastLag;
+    int64_t maxLag;
+    int32_t rejoins;            // earlier images from the same source (rebuilds)
+    int32_t endOfStream;        // on leave: 1 = publisher closed cleanly, 0 = timed out / lost
+    int64_t termLength;         // log buffer term length chosen by the publisher
+    int32_t mtu;
+};
+
+static std::mutex g_imageMutex;
+static std::vector<ImageRecord> g_images;  // guarded by g_imageMutex
+
+// Image positions restored from the persistent segment: a rejoining session
+// reports how far past its saved position it joined. Guarded by g_imageMutex.
+static constexpr int PERSIST_MAX_IMAGES = 16;
+
+struct PersistedImage
+{
+    int32_t sessionId;
+    int32_t reserved;
+    int64_t position;
+};
+
+static PersistedImage g_resumeImages[PERSIST_MAX_IMAGES];
+static int g_resumeImageCount = 0;
+
+struct PublisherPositionQuery
+{
+    int64_t correlationId;
+    int32_t sessionId;
+    int32_t streamId;
+    int32_t counterId;
+};
+
+static void findPublisherPositionCounter(
+    int64_t /*value*/, int32_t id, int32_t typeId,
+    const uint8_t* key, size_t keyLength,
+    const char* /*label*/, size_t /*labelLength*/, void* clientd)
+{
+    PublisherPositionQuery* q = (PublisherPositionQuery*)clientd;
+    if (q->counterId >= 0 || keyLength < 16) return;
+    if (rd_i32_le(key + 8) != q->sessionId || rd_i32_le(key + 12) != q->streamId) return;
+    if ((typeId == AERON_RECEIVER_HWM_TYPE_ID && rd_i64_le(key) == q->correlationId) ||
+        typeId == AERON_PUBLISHER_POSITION_TYPE_ID)
+        q->counterId = id;
+}
+
+static inline int64_t readCounter(int32_t counterId)
+{
+    if (counterId < 0 || !g_aeron) return 0;
+    aeron_counters_reader_t* reader = aeron_counters_reader(g_aeron);
+    int64_t* addr = reader ? aeron_counters_reader_addr(reader, counterId) : nullptr;
+    return addr ? *(volatile int64_t*)addr : 0;
+}
+
+// Client conductor thread
+static void onAvailableImage(void* /*clientd*/, aeron_subscription_t* /*subscription*/, aeron_image_t* image)
+{
+    aeron_image_constants_t constants;
+    if (aeron_image_constants(image, &constants) < 0) return;
+
+    aeron_subscription_constants_t subConstants;
+    if (aeron_subscription_constants(constants.subscription, &subConstants) < 0) return;
+
+    PublisherPositionQuery q{ constants.correlation_id, constants.session_id, subConstants.stream_id, -1 };
+    aeron_counters_reader_t* reader = g_aeron ? aeron_counters_reader(g_aeron) : nullptr;
+    if (reader) aeron_counters_reader_foreach_counter(reader, findPublisherPositionCounter, &q);
+
+    ImageRecord rec{};
+    rec.sessionId = constants.session_id;
+    rec.correlationId = constants.correlation_id;
+    std::snprintf(rec.source, sizeof(rec.source), "%s", constants.source_identity ? constants.source_identity : "");
+    rec.joinNs = wallClockNanos();
+    rec.joinPosition = constants.join_position;
+    rec.subscriberPositionId = constants.subscriber_position_id;
+    rec.publisherPositionId = q.counterId;
+    rec.lastPosition = constants.join_position;
+    rec.termLength = (int64_t)constants.term_buffer_length;
+    rec.mtu = (int32_t)constants.mtu_length;
+
+    {
+        std::lock_guard<std::mutex> lock(g_imageMutex);
+        for (int i = 0; i < g_resumeImageCount; i++)
+        {
+            if (g_resumeImages[i].sessionId != rec.sessionId) continue;
+            if (rec.joinPosition > g_resumeImages[i].position)
+                counterAdd(CNT_RESUME_GAP_BYTES, rec.joinPosition - g_resumeImages[i].position);
+            g_resumeImages[i] = g_resumeImages[--g_resumeImageCount];
+            break;
+        }
+
+        // A returning source replaces its old record and counts as a rebuild
+        int slot = -1;
+        int oldest = -1;
+        for (int i = 0; i < (int)g_images.size(); i++)
+        {
+            const ImageRecord& r = g_images[i];
+            if (r.leaveNs == 0) continue;
+            if (std::strcmp(r.source, rec.source) == 0) { slot = i; break; }
+            if (oldest < 0 || r.leaveNs < g_images[oldest].leaveNs) oldest = i;
+        }
+        if (slot >= 0)
+        {
+            rec.rejoins = g_images[slot].rejoins + 1;
+            g_images[slot] = rec;
+        }
+        else if ((int)g_images.size() < MAX_IMAGE_RECORDS)
+            g_images.push_back(rec);
+        else if (oldest >= 0)
+            g_images[oldest] = rec;
+    }
+    counterAdd(CNT_IMAGES_JOINED, 1);
+}
+
+// Client conductor thread
+static void onUnavailableImage(void* /*clientd*/, aeron_subscription_t* /*subscription*/, aeron_image_t* image)
+{
+    aeron_image_constants_t constants;
+    if (aeron_image_constants(image, &constants) < 0) return;
+
+    {
+        std::lock_guard<std::mutex> lock(g_imageMutex);
+        for (auto& r : g_images)
+        {
+            if (r.correlationId != constants.correlation_id || r.leaveNs != 0) continue;
+            r.leaveNs = wallClockNanos();
+            r.endOfStream = aeron_image_is_end_of_stream(image) ? 1 : 0;
+            r.lastPosition = aeron_image_position(image);
+            break;
+        }
+    }
+    counterAdd(CNT_IMAGES_LEFT, 1);
+}
+
+// Refresh positions/lag of active images from the driver counters
+static void sampleImageLag()
+{
+    int64_t worst = 0;
+    {
+        std::lock_guard<std::mutex> lock(g_imageMutex);
+        for (auto& r : g_images)
+        {
+            if (r.leaveNs != 0) continue;
+            r.lastPosition = readCounter(r.subscriberPositionId);
+            if (r.publisherPositionId < 0) continue;
+            const int64_t pubPos = readCounter(r.publisherPositionId);
+            r.lastLag = pubPos > r.lastPosition ? pubPos - r.lastPosition : 0;
+            if (r.lastLag > r.maxLag) r.maxLag = r.lastLag;
+            if (r.lastLag > worst) worst = r.lastLag;
+        }
+    }
+    counterMax(CNT_IMAGE_LAG_MAX, worst);
+}
+
+// ===============================
+// Persistent signal state
+// ===============================
+// With persistence on (AeronBridge_SetPersistence), Stop snapshots the queued
+// signals and image positions into a named mapping whose handle is never
+// closed: it lives until the terminal exits. Stop then closes the subscription
+// and, when no publisher uses it, the Aeron client as usual, so no conductor
+// thread outlives the EA (a DLL unload under a running client thread crashes
+// the terminal, see CRASH_FIX_V20_8_1.md) and no idle subscription holds back
+// flow control. StartW for the same channel and stream, from this or a freshly
+// loaded DLL instance, restores the queue and resubscribes at the live position;
+// what was published in between is counted as resume gap bytes, not replayed.
+static constexpr uint32_t PERSIST_MAGIC = 0xA330FE57;
+static constexpr uint32_t PERSIST_VERSION = 1;
+static constexpr int PERSIST_MAX_SIGNALS = 1024;
+static constexpr int PERSIST_CHANNEL_LEN = 256;
+
+struct PersistedSignal
+{
+    int32_t lane;
+    int32_t merged;
+    int64_t signalId;
+    int64_t originNs;
+    int32_t csvLen;
+    char csv[SIGNAL_CSV_MAX];
+};
+
+struct PersistSegment
+{
+    uint32_t magic;          // written last
+    uint32_t version;
+    int32_t streamId;
+    int32_t signalCount;
+    int32_t imageCount;
+    int32_t reserved;
+    int64_t savedNs;
+    int64_t nextSignalId;    // keeps ids (and ack correlation) monotonic across reloads
+    char channel[PERSIST_CHANNEL_LEN];
+    PersistedImage images[PERSIST_MAX_IMAGES];
+    PersistedSignal signals[PERSIST_MAX_SIGNALS];
+};
+
+static std::atomic<int> g_persistEnabled{ 0 };
+static PersistSegment* g_persistSegment = nullptr;  // mapped once per DLL instance, never unmapped
+static std::string g_subChannel;                    // channel of the current subscription
+
+static PersistSegment* openPersistSegment()
+{
+    if (g_persistSegment) return g_persistSegment;
+
+    wchar_t name[64];
+    std::swprintf(name, 64, L"Local\\AeronBridge.State.%u", (unsigned)GetCurrentProcessId());
+
+    // The handle is deliberately kept open for the life of the process
+    HANDLE mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, (DWORD)sizeof(PersistSegment), name);
+    if (!mapping)
+    {
+        setError("SetPersistence: CreateFileMapping failed, error " + std::to_string((unsigned long)GetLastError()));
+        return nullptr;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(PersistSegment));
+    if (!view)
+    {
+        setError("SetPersistence: MapViewOfFile failed, error " + std::to_string((unsigned long)GetLastError()));
+        CloseHandle(mapping);
+        return nullptr;
+    }
+    g_persistSegment = (PersistSegment*)view;
+    return g_persistSegment;
+}
+
+// Caller holds g_sigMutex. Queued signals in arrival order (lanes merged by
+// enqueueSeq) plus the position of every active image.
+static void snapshotSignalsLocked(PersistSegment* seg)
+{
+    seg->magic = 0;
+    flushDueNettingLocked(0, true);
+
+    size_t offset[LANE_COUNT] = {};
+    int n = 0;
+    while (n < PERSIST_MAX_SIGNALS)
+    {
+        int best = -1;
+        for (int i = 0; i < LANE_COUNT; i++)
+        {
+            const SignalLane& lane = g_lanes[i];
+            if (offset[i] >= lane.count) continue;
+            const QueuedSignal& q = lane.slots[(lane.head + offset[i]) % lane.slots.size()];
+            if (best < 0 || q.enqueueSeq < g_lanes[best].slots[(g_lanes[best].head + offset[best]) % g_lanes[best].slots.size()].enqueueSeq)
+                best = i;
+        }
+        if (best < 0) break;
+
+        const SignalLane& lane = g_lanes[best];
+        const QueuedSignal& q = lane.slots[(lane.head + offset[best]) % lane.slots.size()];
+        PersistedSignal& out = seg->signals[n++];
+        out.lane = best;
+        out.merged = q.merged;
+        out.signalId = q.signalId;
+        out.originNs = q.originNs;
+        out.csvLen = q.csvLen;
+        std::memcpy(out.csv, q.csv, (size_t)q.csvLen);
+        offset[best]++;
+    }
+    seg->signalCount = n;
+
+    {
+        std::lock_guard<std::mutex> lock(g_imageMutex);
+        int images = 0;
+        for (const auto& r : g_images)
         {
-            map = it->second;
-            isMapped = true;
+            if (r.leaveNs != 0 || images >= PERSIST_MAX_IMAGES) continue;
+            seg->images[images].sessionId = r.sessionId;
+            seg->images[images].reserved = 0;
+            seg->images[images].position = r.lastPosition;
+            images++;
         }
+        seg->imageCount = images;
+    }
+
+    seg->version = PERSIST_VERSION;
+    seg->streamId = g_subStreamId.load(std::memory_order_relaxed);
+    std::snprintf(seg->channel, sizeof(seg->channel), "%s", g_subChannel.c_str());
+    seg->savedNs = wallClockNanos();
+    seg->nextSignalId = g_nextSignalId.load(std::memory_order_relaxed);
+    seg->magic = PERSIST_MAGIC;
+}
+
+// Caller holds g_sigMutex. Requeues a snapshot left by an earlier DLL instance
+// into empty lanes (TTL still applies on dequeue); consumed either way.
+static void restoreSignalsLocked(PersistSegment* seg, const std::string& channel, int streamId)
+{
+    if (seg->magic != PERSIST_MAGIC || seg->version != PERSIST_VERSION) return;
+    seg->magic = 0;
+
+    if (seg->nextSignalId > g_nextSignalId.load(std::memory_order_relaxed))
+        g_nextSignalId.store(seg->nextSignalId, std::memory_order_relaxed);
+
+    if (totalQueuedLocked() > 0 || seg->streamId != streamId || channel != seg->channel)
+        return;
+
+    counterAdd(CNT_WARM_RESUMES, 1);
+    const int count = std::min(seg->signalCount, PERSIST_MAX_SIGNALS);
+    for (int i = 0; i < count; i++)
+    {
+        const PersistedSignal& sig = seg->signals[i];
+        if (sig.lane < 0 || sig.lane >= LANE_COUNT || sig.csvLen < 0 || sig.csvLen >= SIGNAL_CSV_MAX) continue;
+        if (enqueueSignalLocked(sig.lane, sig.signalId, sig.originNs, sig.merged, sig.csv, sig.csvLen) != ENQ_REJECTED)
+            counterAdd(CNT_SIGNALS_RESTORED, 1);
+    }
+
+    std::lock_guard<std::mutex> lock(g_imageMutex);
+    g_resumeImageCount = std::min(seg->imageCount, PERSIST_MAX_IMAGES);
+    std::memcpy(g_resumeImages, seg->images, sizeof(PersistedImage) * (size_t)g_resumeImageCount);
+}
+
+// ===============================
+// Source liveness
+// ===============================
+// One row per (source, session) that has sent a heartbeat. A row goes stale
+// when nothing arrived within the liveness timeout (default 3x the interval the
+// publisher advertises); the transition raises ERR_SOURCE_STALE once. Checked
+// from Poll at most every millisecond, so detection takes timeout + poll period.
+static constexpr int MAX_LIVENESS_SOURCES = 64;
+static constexpr int64_t LIVENESS_CHECK_NS = 1000000;  // 1 ms
+
+struct SourceLiveness
+{
+    char source[SOURCE_LEN + 1];
+    int32_t sessionId;
+    int32_t intervalMs;      // advertised by the publisher
+    int64_t lastSeenNs;      // local receive time (UTC ns)
+    int64_t lastSenderNs;    // publisher timestamp of the last heartbeat
+    int64_t lastSequence;
+    int64_t beats;
+    int64_t missed;          // sequence gaps
+    int32_t staleEvents;
+    bool stale;
+};
+
+static std::mutex g_livenessMutex;
+static SourceLiveness g_liveness[MAX_LIVENESS_SOURCES];
+static std::atomic<int> g_livenessCount{ 0 };
+static std::atomic<int64_t> g_livenessTimeoutNs{ 0 };  // 0 = 3x advertised interval
+static std::atomic<int64_t> g_nextLivenessCheckNs{ 0 };
+
+static inline int64_t livenessTimeoutNs(const SourceLiveness& r)
+{
+    const int64_t fixed = g_livenessTimeoutNs.load(std::memory_order_relaxed);
+    return fixed > 0 ? fixed : (int64_t)r.intervalMs * 3 * 1000000;
+}
+
+// Caller holds g_livenessMutex
+static void checkLivenessLocked(int64_t nowNs)
+{
+    const int count = g_livenessCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; i++)
+    {
+        SourceLiveness& r = g_liveness[i];
+        const int64_t ageNs = nowNs - r.lastSeenNs;
+        if (r.stale || ageNs <= livenessTimeoutNs(r)) continue;
+
+        r.stale = true;
+        r.staleEvents++;
+        counterAdd(CNT_SOURCES_STALE, 1);
+        recordError(ERR_SOURCE_STALE, ORIGIN_SUBSCRIBER, g_subStreamId.load(std::memory_order_relaxed), r.source, ageNs / 1000000);
+    }
+}
+
+static void checkLiveness()
+{
+    if (g_livenessCount.load(std::memory_order_relaxed) == 0) return;
+    const int64_t nowNs = wallClockNanos();
+    if (nowNs < g_nextLivenessCheckNs.load(std::memory_order_relaxed)) return;
+    g_nextLivenessCheckNs.store(nowNs + LIVENESS_CHECK_NS, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(g_livenessMutex);
+    checkLivenessLocked(nowNs);
+}
+
+static void onHeartbeat(const uint8_t* buffer, aeron_header_t* header)
+{
+    counterAdd(CNT_HEARTBEATS_RECEIVED, 1);
+
+    int32_t sessionId = 0;
+    aeron_header_values_t values;
+    if (header && aeron_header_values(header, &values) == 0)
+        sessionId = values.frame.session_id;
+
+    char source[SOURCE_LEN + 1];
+    copy_ascii_trim0(source, buffer + HEARTBEAT_SOURCE_OFFSET, SOURCE_LEN);
+    const int64_t sequence = rd_i64_le(buffer + HEARTBEAT_SEQUENCE_OFFSET);
+
+    std::lock_guard<std::mutex> lock(g_livenessMutex);
+    const int count = g_livenessCount.load(std::memory_order_relaxed);
+    SourceLiveness* r = nullptr;
+    for (int i = 0; i < count; i++)
+    {
+        if (g_liveness[i].sessionId == sessionId && std::strcmp(g_liveness[i].source, source) == 0)
+        {
+            r = &g_liveness[i];
+            break;
+        }
+    }
+    if (!r)
+    {
+        if (count >= MAX_LIVENESS_SOURCES) return;
+        r = &g_liveness[count];
+        std::memset(r, 0, sizeof(*r));
+        std::memcpy(r->source, source, sizeof(source));
+        r->sessionId = sessionId;
+        g_livenessCount.store(count + 1, std::memory_order_relaxed);
+    }
+    else if (sequence > r->lastSequence + 1)
+    {
+        r->missed += sequence - r->lastSequence - 1;
+    }
+
+    r->intervalMs = rd_i32_le(buffer + HEARTBEAT_INTERVAL_OFFSET);
+    r->lastSeenNs = wallClockNanos();
+    r->lastSenderNs = rd_i64_le(buffer + HEARTBEAT_TIMESTAMP_OFFSET);
+    r->lastSequence = sequence;
+    r->beats++;
+    r->stale = false;
+}
+
+// ===============================
+// Session calendar
+// ===============================
+// Per futures prefix weekly trading windows, compiled once into sorted,
+// merged UTC minute-of-week intervals so the decode path only does a binary
+// search. Entries outside a session are dropped before formatting; within
+// closeBufferMinutes of a session end they are dropped or converted to a
+// force exit (policy). Exits, risk signals and force exits always pass.
+static constexpr int MAX_SESSION_CALENDARS = 32;
+static constexpr int MAX_SESSION_WINDOWS = 64;
+static constexpr int MINUTES_PER_WEEK = 7 * 24 * 60;
+
+enum SessionNearClosePolicy
+{
+    SESSION_NEAR_CLOSE_GATE = 0,        // drop entries
+    SESSION_NEAR_CLOSE_FORCE_EXIT = 1   // turn entries into AERON_FORCE_EXIT (10)
+};
+
+struct SessionCalendar
+{
+    char prefix[SYMBOL_LEN + 1];
+    int32_t windowCount;
+    int32_t startMin[MAX_SESSION_WINDOWS];  // UTC minute of week (Sunday 00:00 = 0)
+    int32_t endMin[MAX_SESSION_WINDOWS];    // exclusive, <= MINUTES_PER_WEEK
+    int32_t closeBufferMin;
+    int32_t nearClosePolicy;
+    int64_t gated;
+    int64_t converted;
+};
+
+static std::mutex g_sessionMutex;
+static SessionCalendar g_sessions[MAX_SESSION_CALENDARS];  // guarded by g_sessionMutex
+static int g_sessionCount = 0;
+static std::atomic<int> g_sessionsActive{ 0 };
+
+static int minuteOfWeekUtc(int64_t utcNs)
+{
+    const int64_t minutes = utcNs / 60000000000LL;
+    // 1970-01-01 was a Thursday (day 4 with Sunday = 0)
+    return (int)((minutes + 4 * 24 * 60) % MINUTES_PER_WEEK);
+}
+
+// Minutes until the session containing minute ends; -1 if outside every window.
+// A window running into the week boundary continues in one starting at 0.
+static int sessionMinutesToClose(const SessionCalendar& c, int minute)
+{
+    int lo = 0, hi = c.windowCount - 1, found = -1;
+    while (lo <= hi)
+    {
+        const int mid = (lo + hi) / 2;
+        if (c.startMin[mid] <= minute) { found = mid; lo = mid + 1; }
+        else hi = mid - 1;
+    }
+    if (found < 0 || minute >= c.endMin[found]) return -1;
+
+    int toClose = c.endMin[found] - minute;
+    if (c.endMin[found] == MINUTES_PER_WEEK && c.windowCount > 1 && c.startMin[0] == 0)
+        toClose += c.endMin[0];
+    return toClose;
+}
+
+// Caller holds g_sessionMutex
+static SessionCalendar* findSessionLocked(const char* instrument)
+{
+    const size_t n = futPrefixLength(instrument);
+    for (int i = 0; i < g_sessionCount; i++)
+    {
+        const SessionCalendar& c = g_sessions[i];
+        if (std::strlen(c.prefix) == n && std::strncmp(c.prefix, instrument, n) == 0)
+            return &g_sessions[i];
+    }
+    return nullptr;
+}
+
+// Returns false if the signal must be dropped; may rewrite action.
+static bool sessionAdmit(uint16_t& action, const char* instrument, int64_t utcNs)
+{
+    if (action < 1 || action > 4) return true;  // only entries are gated
+
+    std::lock_guard<std::mutex> lock(g_sessionMutex);
+    SessionCalendar* c = findSessionLocked(instrument);
+    if (!c) return true;
+
+    const int toClose = sessionMinutesToClose(*c, minuteOfWeekUtc(utcNs));
+    if (toClose >= 0 && toClose > c->closeBufferMin) return true;
+
+    if (toClose >= 0 && c->nearClosePolicy == SESSION_NEAR_CLOSE_FORCE_EXIT)
+    {
+        action = 10;
+        if (!t_warmupFrame)
+        {
+            c->converted++;
+            counterAdd(CNT_SESSION_CONVERTED, 1);
+        }
+        return true;
+    }
+
+    if (!t_warmupFrame)
+    {
+        c->gated++;
+        counterAdd(CNT_SESSION_GATED, 1);
+    }
+    return false;
+}
+
+static int parseDayName(const char* p)
+{
+    static const char* const DAYS[7] = { "sun", "mon", "tue", "wed", "thu", "fri", "sat" };
+    char lower[3];
+    for (int i = 0; i < 3; i++)
+    {
+        if (!p[i]) return -1;
+        lower[i] = (char)((p[i] >= 'A' && p[i] <= 'Z') ? p[i] - 'A' + 'a' : p[i]);
+    }
+    for (int d = 0; d < 7; d++)
+    {
+        if (std::memcmp(lower, DAYS[d], 3) == 0) return d;
+    }
+    return -1;
+}
+
+static bool parseClock(const char* p, int* minutes)
+{
+    int h = 0, m = 0;
+    if (std::sscanf(p, "%d:%d", &h, &m) != 2) return false;
+    if (h < 0 || h > 24 || m < 0 || m > 59 || (h == 24 && m != 0)) return false;
+    *minutes = h * 60 + m;
+    return true;
+}
+
+// Schedule: comma-separated "day=HH:MM-HH:MM" or "day-day=HH:MM-HH:MM" items in
+// exchange-local time; start > end runs past midnight into the next day.
+// Fills c's windows in UTC, sorted and merged. Returns false on a parse error.
+static bool compileSessionCalendar(const std::string& schedule, int utcOffsetMinutes, SessionCalendar& c, std::string* err)
+{
+    int32_t starts[MAX_SESSION_WINDOWS * 2];
+    int32_t ends[MAX_SESSION_WINDOWS * 2];
+    int count = 0;
+
+    size_t pos = 0;
+    while (pos < schedule.size())
+    {
+        size_t next = schedule.find(',', pos);
+        if (next == std::string::npos) next = schedule.size();
+        std::string item = schedule.substr(pos, next - pos);
+        pos = next + 1;
+
+        item.erase(0, item.find_first_not_of(" \t"));
+        item.erase(item.find_last_not_of(" \t") + 1);
+        if (item.empty()) continue;
+
+        const size_t eq = item.find('=');
+        const size_t dash = item.find('-', eq == std::string::npos ? 0 : eq);
+        if (eq == std::string::npos || dash == std::string::npos)
+        {
+            *err = "bad item '" + item + "' (expected day=HH:MM-HH:MM)";
+            return false;
+        }
+
+        const int firstDay = parseDayName(item.c_str());
+        int lastDay = firstDay;
+        if (eq > 3 && item[3] == '-') lastDay = parseDayName(item.c_str() + 4);
+        int open = 0, close = 0;
+        if (firstDay < 0 || lastDay < 0 ||
+            !parseClock(item.c_str() + eq + 1, &open) || !parseClock(item.c_str() + dash + 1, &close))
+        {
+            *err = "bad item '" + item + "' (expected day=HH:MM-HH:MM)";
+            return false;
+        }
+
+        for (int d = firstDay; ; d = (d + 1) % 7)
+        {
+            int start = d * 1440 + open;
+            int end = d * 1440 + close;
+            if (close <= open) end += 1440;  // overnight
+            // Local -> UTC, then wrap the start into the week
+            start -= utcOffsetMinutes;
+            end -= utcOffsetMinutes;
+            const int shift = ((start % MINUTES_PER_WEEK) + MINUTES_PER_WEEK) % MINUTES_PER_WEEK - start;
+            start += shift;
+            end += shift;
+
+            // Split at the week boundary
+            if (count + 2 > MAX_SESSION_WINDOWS * 2)
+            {
+                *err = "too many windows";
+                return false;
+            }
+            if (end > MINUTES_PER_WEEK)
+            {
+                starts[count] = start; ends[count++] = MINUTES_PER_WEEK;
+                starts[count] = 0; ends[count++] = end - MINUTES_PER_WEEK;
+            }
+            else
+            {
+                starts[count] = start; ends[count++] = end;
+            }
+            if (d == lastDay) break;
+        }
+    }
+
+    // Sort by start (insertion sort, tiny n) and merge overlapping/adjacent windows
+    for (int i = 1; i < count; i++)
+    {
+        const int32_t s0 = starts[i], e0 = ends[i];
+        int j = i - 1;
+        while (j >= 0 && starts[j] > s0) { starts[j + 1] = starts[j]; ends[j + 1] = ends[j]; j--; }
+        starts[j + 1] = s0; ends[j + 1] = e0;
+    }
+    c.windowCount = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (c.windowCount > 0 && starts[i] <= c.endMin[c.windowCount - 1])
+        {
+            if (ends[i] > c.endMin[c.windowCount - 1]) c.endMin[c.windowCount - 1] = ends[i];
+            continue;
+        }
+        if (c.windowCount >= MAX_SESSION_WINDOWS)
+        {
+            *err = "too many windows";
+            return false;
+        }
+        c.startMin[c.windowCount] = starts[i];
+        c.endMin[c.windowCount] = ends[i];
+        c.windowCount++;
+    }
+    return true;
+}
+
+// ===============================
+// Rate limiting
+// ===============================
+// Token buckets per source and per instrument, checked on the raw frame right
+// after header validation so a flooding source is shed before any decode,
+// mapping or queueing. A bucket is created on first sight from the scope's
+// default, or configured per key. The first shed frame of a bucket raises
+// ERR_RATE_LIMITED and sets a sticky alarm. Force exits are never shed.
+// Once the table is full, new keys share one overflow bucket per scope (key
+// "*") rather than going unlimited; the first such frame raises
+// ERR_RATE_TABLE_FULL and sets that bucket's alarm.
+enum RateScope
+{
+    RATE_SCOPE_SOURCE = 0,
+    RATE_SCOPE_INSTRUMENT = 1,
+    RATE_SCOPE_COUNT
+};
+
+static constexpr int MAX_RATE_BUCKETS = 128;
+
+struct RateBucket
+{
+    int scope;
+    char key[INSTRUMENT_LEN + 1];
+    double ratePerSec;
+    double burst;
+    double tokens;
+    int64_t lastNs;          // steady ns of the last refill
+    int64_t passed;
+    int64_t shed;
+    bool configured;         // set by key, not taken from the scope default
+    bool alarm;              // sticky until AeronBridge_ClearRateAlarms
+};
+
+struct RateDefault
+{
+    double ratePerSec;       // 0 = unlimited
+    double burst;
+};
+
+static std::mutex g_rateMutex;
+static RateBucket g_rateBuckets[MAX_RATE_BUCKETS];
+static int g_rateBucketCount = 0;                 // guarded by g_rateMutex
+static RateBucket g_rateOverflow[RATE_SCOPE_COUNT] = {};  // guarded by g_rateMutex, lastNs 0 = unused
+static RateDefault g_rateDefaults[RATE_SCOPE_COUNT] = {};
+static std::atomic<int> g_rateLimitsActive{ 0 };  // any default or keyed limit set
+
+// Compare a NUL-padded frame field with a NUL-terminated key, without copying
+static inline bool fieldEquals(const uint8_t* field, int len, const char* key)
+{
+    int i = 0;
+    for (; i < len && key[i]; i++)
+    {
+        if (field[i] != (uint8_t)key[i]) return false;
+    }
+    return i == len || field[i] == 0;
+}
+
+// Caller holds g_rateMutex. Returns null if the key is unlimited.
+static RateBucket* findRateBucketLocked(int scope, const uint8_t* field, int len)
+{
+    for (int i = 0; i < g_rateBucketCount; i++)
+    {
+        RateBucket& b = g_rateBuckets[i];
+        if (b.scope == scope && fieldEquals(field, len, b.key))
+            return b.ratePerSec > 0.0 ? &b : nullptr;
+    }
+
+    const RateDefault& def = g_rateDefaults[scope];
+    if (def.ratePerSec <= 0.0) return nullptr;
+
+    if (g_rateBucketCount >= MAX_RATE_BUCKETS)
+    {
+        RateBucket& o = g_rateOverflow[scope];
+        if (o.lastNs == 0)
+        {
+            o.scope = scope;
+            o.key[0] = '*';
+            o.ratePerSec = def.ratePerSec;
+            o.burst = def.burst;
+            o.tokens = def.burst;
+            o.lastNs = steadyNanos();
+        }
+        counterAdd(CNT_RATE_OVERFLOW, 1);
+        if (!o.alarm)
+        {
+            o.alarm = true;
+            char key[INSTRUMENT_LEN + 1];
+            copy_ascii_trim0(key, field, len);
+            recordError(ERR_RATE_TABLE_FULL, ORIGIN_SUBSCRIBER, g_subStreamId.load(std::memory_order_relaxed), key, MAX_RATE_BUCKETS);
+        }
+        return &o;
+    }
+
+    RateBucket& b = g_rateBuckets[g_rateBucketCount++];
+    b = RateBucket{};
+    b.scope = scope;
+    copy_ascii_trim0(b.key, field, len);
+    b.ratePerSec = def.ratePerSec;
+    b.burst = def.burst;
+    b.tokens = def.burst;
+    b.lastNs = steadyNanos();
+    return &b;
+}
+
+static inline void refillBucket(RateBucket& b, int64_t nowNs)
+{
+    b.tokens += (double)(nowNs - b.lastNs) * b.ratePerSec / 1e9;
+    if (b.tokens > b.burst) b.tokens = b.burst;
+    b.lastNs = nowNs;
+}
+
+// Both buckets must have a token; neither is charged when one refuses
+static bool rateLimitAdmit(uint16_t action, const uint8_t* source, const uint8_t* instrument)
+{
+    if (!g_rateLimitsActive.load(std::memory_order_relaxed) || action == 10 || t_warmupFrame) return true;
+
+    const int64_t nowNs = steadyNanos();
+    std::lock_guard<std::mutex> lock(g_rateMutex);
+    RateBucket* buckets[RATE_SCOPE_COUNT] = {
+        findRateBucketLocked(RATE_SCOPE_SOURCE, source, SOURCE_LEN),
+        findRateBucketLocked(RATE_SCOPE_INSTRUMENT, instrument, INSTRUMENT_LEN)
+    };
+
+    RateBucket* refused = nullptr;
+    for (RateBucket* b : buckets)
+    {
+        if (!b) continue;
+        refillBucket(*b, nowNs);
+        if (b->tokens < 1.0 && !refused) refused = b;
+    }
+
+    if (refused)
+    {
+        refused->shed++;
+        counterAdd(CNT_RATE_LIMITED, 1);
+        if (!refused->alarm)
+        {
+            refused->alarm = true;
+            recordError(ERR_RATE_LIMITED, ORIGIN_SUBSCRIBER, g_subStreamId.load(std::memory_order_relaxed), refused->key, (int64_t)refused->ratePerSec);
+        }
+        return false;
+    }
+
+    for (RateBucket* b : buckets)
+    {
+        if (!b) continue;
+        b->tokens -= 1.0;
+        b->passed++;
+    }
+    return true;
+}
+
+// ===============================
+// Latest-state cache
+// ===============================
+// Subscriber side: the last frame seen per (source, instrument), updated on
+// every signal frame (filtered exits included) so an EA that starts mid-session
+// can reconcile from AeronBridge_GetSignalState instead of waiting for the next
+// signal. Publisher state snapshots seed keys this terminal has not seen, or
+// has only seen older frames of; snapshots are never delivered as signals.
+static constexpr int MAX_STATE_ENTRIES = 128;
+
+struct SignalState
+{
+    char source[SOURCE_LEN + 1];
+    char instrument[INSTRUMENT_LEN + 1];
+    char mt5Symbol[MT5_SYMBOL_LEN + 1];  // routed frames only, else from the mapping
+    uint16_t lastAction;
+    int64_t lastNs;          // frame timestamp
+    uint16_t entryAction;    // last entry (1-4), 0 = none seen
+    int32_t entryQty;
+    int64_t entryNs;
+    int32_t direction;       // +1 long, -1 short, 0 flat
+    int64_t frames;          // live frames (snapshots not included)
+    bool seeded;             // last update came from a snapshot
+};
+
+static std::mutex g_stateMutex;
+static SignalState g_states[MAX_STATE_ENTRIES];
+static int g_stateCount = 0;  // guarded by g_stateMutex
+
+// Position the source wants after action, given the one it wanted before
+static int32_t directionAfter(int32_t direction, uint16_t action)
+{
+    switch (action)
+    {
+    case 1: case 2: return 1;
+    case 3: case 4: return -1;
+    case 5: case 7: return direction > 0 ? 0 : direction;
+    case 6: case 8: return direction < 0 ? 0 : direction;
+    case 9: case 10: return 0;
+    default: return direction;
+    }
+}
+
+// Frame fields are passed raw so signal, routed and snapshot frames share one
+// path. mt5Symbol may be null. Returns false if nothing was updated.
+static bool updateSignalState(
+    const uint8_t* source, const uint8_t* instrument, const uint8_t* mt5Symbol,
+    uint16_t action, int32_t qty, int64_t frameNs, bool fromSnapshot)
+{
+    std::lock_guard<std::mutex> lock(g_stateMutex);
+    SignalState* s = nullptr;
+    for (int i = 0; i < g_stateCount; i++)
+    {
+        if (fieldEquals(instrument, INSTRUMENT_LEN, g_states[i].instrument)
+            && fieldEquals(source, SOURCE_LEN, g_states[i].source))
+        {
+            s = &g_states[i];
+            break;
+        }
+    }
+    if (!s)
+    {
+        if (g_stateCount >= MAX_STATE_ENTRIES) return false;
+        s = &g_states[g_stateCount++];
+        *s = SignalState{};
+        copy_ascii_trim0(s->source, source, SOURCE_LEN);
+        copy_ascii_trim0(s->instrument, instrument, INSTRUMENT_LEN);
+    }
+    else if (fromSnapshot && s->lastNs >= frameNs)
+    {
+        return false;  // live frames (or this snapshot) already got here
+    }
+
+    if (mt5Symbol) copy_ascii_trim0(s->mt5Symbol, mt5Symbol, MT5_SYMBOL_LEN);
+    s->lastAction = action;
+    s->lastNs = frameNs;
+    if (action >= 1 && action <= 4)
+    {
+        s->entryAction = action;
+        s->entryQty = qty;
+        s->entryNs = frameNs;
+    }
+    s->direction = directionAfter(s->direction, action);
+    s->seeded = fromSnapshot;
+    if (!fromSnapshot) s->frames++;
+    return true;
+}
+
+static void onStateSnapshot(const uint8_t* buffer)
+{
+    const uint8_t* f = buffer + STATE_SIGNAL_OFFSET;
+    if (checkSignalFrame(f, FRAME_SIZE) != FRAME_OK) return;
+    if (updateSignalState(f + SOURCE_OFFSET, f + INSTRUMENT_OFFSET, nullptr,
+            rd_u16_le(f + ACTION_OFFSET), rd_i32_le(f + QTY_OFFSET), rd_i64_le(f + TIMESTAMP_OFFSET), true))
+        counterAdd(CNT_STATE_SEEDED, 1);
+}
+
+// Publisher side: the last frame published per (source, instrument), re-sent
+// by the state snapshot thread (AeronBridge_StartStateSnapshots).
+static std::mutex g_pubStateMutex;
+static uint8_t g_pubStates[MAX_STATE_ENTRIES][FRAME_SIZE];
+static int g_pubStateCount = 0;  // guarded by g_pubStateMutex
+
+static void rememberPublishedState(const uint8_t* frame)
+{
+    std::lock_guard<std::mutex> lock(g_pubStateMutex);
+    for (int i = 0; i < g_pubStateCount; i++)
+    {
+        uint8_t* f = g_pubStates[i];
+        if (std::memcmp(f + INSTRUMENT_OFFSET, frame + INSTRUMENT_OFFSET, INSTRUMENT_LEN) == 0
+            && std::memcmp(f + SOURCE_OFFSET, frame + SOURCE_OFFSET, SOURCE_LEN) == 0)
+        {
+            std::memcpy(f, frame, FRAME_SIZE);
+            return;
+        }
+    }
+    if (g_pubStateCount >= MAX_STATE_ENTRIES) return;
+    std::memcpy(g_pubStates[g_pubStateCount++], frame, FRAME_SIZE);
+}
+
+// ===============================
+// Fragment handler
+// ===============================
+// A decoded + mapped signal, before CSV formatting
+struct MappedSignal
+{
+    uint16_t action;
+    int32_t qty;
+    int32_t slPoints;
+    int32_t ptPoints;
+    float confidence;
+    char sym[SYMBOL_LEN + 1];
+    char mt5Symbol[MT5_SYMBOL_LEN + 1];
+    char src[SOURCE_LEN + 1];
+    char inst[INSTRUMENT_LEN + 1];
+};
+
+struct SignalMeta
+{
+    int64_t signalId;
+    int64_t originNs;
+    int64_t publishNs;
+    int64_t receiveWallNs;
+    int32_t merged;      // source signals folded into this one by netting (1 = none)
+};
+
+// action,qty,sl_points,pt_points,confidence,symbol,mt5_symbol,source,instrument
+static int formatSignalCsv(const MappedSignal& m, char* csv, size_t csvSize)
+{
+    int csvLen = std::snprintf(
+        csv, csvSize,
+        "%u,%d,%d,%d,%.2f,%s,%s,%s,%s",
+        (unsigned)m.action,
+        (int)m.qty,
+        (int)m.slPoints,
+        (int)m.ptPoints,
+        (double)m.confidence,
+        m.sym,
+        m.mt5Symbol,
+        m.src,
+        m.inst);
+    if (csvLen < 0) csvLen = 0;
+    if (csvLen >= (int)csvSize) csvLen = (int)csvSize - 1;
+    return csvLen;
+}
+
+// Caller holds g_sigMutex. Queue the formatted CSV in its priority lane; lane
+// policy decides what is dropped when full.
+static void enqueueSignalCsvLocked(
+    int laneId,
+    const SignalMeta& meta,
+    const char* csv,
+    int csvLen,
+    const char* inst,
+    bool tracing)
+{
+    if (t_warmupFrame)
+    {
+        warmLaneSlotLocked(laneId, csv, csvLen);
+        return;
+    }
+
+    const int enq = enqueueSignalLocked(laneId, meta.signalId, meta.originNs, meta.merged, csv, csvLen);
+    broadcastSignalLocked(laneId, meta.signalId, meta.originNs, meta.merged, csv, csvLen);
+    if (enq != ENQ_REJECTED)
+    {
+        if (tracing) traceStage(meta.signalId, TRACE_STAGE_ENQUEUED);
+        rememberDelivered(meta.signalId, meta.publishNs, meta.receiveWallNs);
+        t_enqueuedThisThread++;
+        counterAdd(CNT_SIGNALS_ENQUEUED, 1);
+        counterMax(CNT_QUEUE_DEPTH_HWM, (int64_t)totalQueuedLocked());
+    }
+    if (enq != ENQ_OK)
+    {
+        t_droppedThisThread++;
+        counterAdd(CNT_QUEUE_FULL_DROPS, 1);
+        recordError(ERR_QUEUE_FULL, ORIGIN_SUBSCRIBER, g_subStreamId.load(std::memory_order_relaxed), inst, (int64_t)g_lanes[laneId].slots.size());
+    }
+}
+
+// ===============================
+// Signal netting
+// ===============================
+// Optional coalescing window keyed on the mapped symbol. Entries arriving within
+// the window supersede each other: the newest direction wins, with the newest
+// entry's SL/PT and the summed qty of the same-direction entries since the last
+// reversal. The window always delivers one entry when it closes, so a long 1
+// followed by a short 1 goes out as short 1, not as nothing. A force exit
+// drops pending entries for its symbol and goes out at once; stop-loss / profit
+// target release the pending entry without waiting (lane priority still
+// delivers the risk signal ahead of it). Windows close on the next poll or read
+// after their deadline. Guarded by g_sigMutex.
+static constexpr int MAX_NET_PENDING = 64;
+
+struct NetPending
+{
+    bool active;
+    bool isLong;             // direction of the newest entry
+    MappedSignal last;       // newest entry (action, SL/PT and symbol delivered)
+    SignalMeta meta;         // newest signal id / timestamps, earliest origin, merged count
+    int64_t qty;             // sum of the entries since the last reversal
+    int64_t deadlineNs;
+};
+
+static std::atomic<int64_t> g_nettingWindowNs{ 0 };  // 0 = off
+static NetPending g_netPending[MAX_NET_PENDING];
+
+static inline bool isEntryAction(uint16_t action)
+{
+    return action >= 1 && action <= 4;
+}
+
+static NetPending* findNetPendingLocked(const char* mt5Symbol)
+{
+    if (g_netActive == 0) return nullptr;
+    for (auto& p : g_netPending)
+    {
+        if (p.active && std::strcmp(p.last.mt5Symbol, mt5Symbol) == 0) return &p;
+    }
+    return nullptr;
+}
+
+static void releaseNetPendingLocked(NetPending& p)
+{
+    p.active = false;
+    g_netActive--;
+}
+
+// Deliver the net instruction of one pending symbol
+static void flushNetPendingLocked(NetPending& p, bool tracing)
+{
+    MappedSignal m = p.last;
+    m.qty = (int32_t)(p.qty < INT32_MAX ? p.qty : INT32_MAX);
+
+    char csv[SIGNAL_CSV_MAX];
+    const int csvLen = formatSignalCsv(m, csv, sizeof(csv));
+    const SignalMeta meta = p.meta;
+    releaseNetPendingLocked(p);
+    enqueueSignalCsvLocked(laneForAction(m.action), meta, csv, csvLen, m.inst, tracing);
+}
+
+// Caller holds g_sigMutex. Delivers every pending symbol whose window closed.
+static void flushDueNettingLocked(int64_t nowNs, bool all)
+{
+    if (g_netActive == 0) return;
+    const bool tracing = g_traceEnabled.load(std::memory_order_relaxed) != 0;
+    for (auto& p : g_netPending)
+    {
+        if (p.active && (all || nowNs >= p.deadlineNs))
+            flushNetPendingLocked(p, tracing);
+    }
+}
+
+// Closes due windows from paths that don't hold g_sigMutex (poll, consumer read).
+static void flushDueNetting()
+{
+    if (g_nettingWindowNs.load(std::memory_order_relaxed) <= 0) return;
+    std::lock_guard<std::mutex> lock(g_sigMutex);
+    flushDueNettingLocked(wallClockNanos(), false);
+}
+
+// Caller holds g_sigMutex. Returns true if the signal was absorbed into the
+// netting window; otherwise the caller queues it (meta.merged may have grown).
+static bool netSignalLocked(const MappedSignal& m, SignalMeta& meta, bool tracing)
+{
+    NetPending* p = findNetPendingLocked(m.mt5Symbol);
+
+    if (!isEntryAction(m.action))
+    {
+        if (!p) return false;
+        if (m.action == 10)
+        {
+            // Force exit supersedes everything pending on the symbol
+            counterAdd(CNT_SIGNALS_NETTED, p->meta.merged);
+            meta.merged += p->meta.merged;
+            releaseNetPendingLocked(*p);
+        }
+        else
+        {
+            flushNetPendingLocked(*p, tracing);
+        }
+        return false;
+    }
+
+    const bool isLong = m.action == 1 || m.action == 2;
+
+    if (!p)
+    {
+        for (auto& slot : g_netPending)
+        {
+            if (!slot.active) { p = &slot; break; }
+        }
+        if (!p) return false;  // table full: deliver unnetted
+
+        p->active = true;
+        p->isLong = isLong;
+        p->meta = meta;
+        p->qty = 0;
+        p->deadlineNs = meta.receiveWallNs + g_nettingWindowNs.load(std::memory_order_relaxed);
+        g_netActive++;
+    }
+    else
+    {
+        counterAdd(CNT_SIGNALS_NETTED, 1);
+        const int64_t origin = p->meta.originNs < meta.originNs ? p->meta.originNs : meta.originNs;
+        const int32_t merged = p->meta.merged + meta.merged;
+        p->meta = meta;
+        p->meta.originNs = origin;
+        p->meta.merged = merged;
+    }
+
+    if (p->isLong != isLong)
+    {
+        // Reversal: the new direction replaces everything pending
+        counterAdd(CNT_NET_REVERSALS, 1);
+        p->isLong = isLong;
+        p->qty = 0;
+    }
+    p->last = m;
+    p->qty += m.qty;
+    return true;
+}
+
+// Shared tail of the raw and routed paths
+static void deliverMappedSignal(MappedSignal& m, SignalMeta& meta, bool tracing)
+{
+    // Session gate on the final action, before any formatting or queueing
+    if (g_sessionsActive.load(std::memory_order_relaxed) && !sessionAdmit(m.action, m.inst, meta.receiveWallNs))
+        return;
+
+    if (g_nettingWindowNs.load(std::memory_order_relaxed) > 0 && !t_warmupFrame)
+    {
+        std::lock_guard<std::mutex> lock(g_sigMutex);
+        if (netSignalLocked(m, meta, tracing)) return;
+    }
+
+    char csv[SIGNAL_CSV_MAX];
+    const int csvLen = formatSignalCsv(m, csv, sizeof(csv));
+
+    std::lock_guard<std::mutex> lock(g_sigMutex);
+    enqueueSignalCsvLocked(laneForAction(m.action), meta, csv, csvLen, m.inst, tracing);
+}
+
+static bool expiredOnArrival(int laneId, int64_t originNs, int64_t nowNs)
+{
+    if (!isSignalExpired(laneId, originNs, nowNs)) return false;
+    counterAdd(CNT_EXPIRED_AT_ENQUEUE, 1);
+    std::lock_guard<std::mutex> lock(g_sigMutex);
+    g_lanes[laneId].expired++;
+    return true;
+}
+
+// The router resolves symbol and points; transforms are this terminal's own
+static void applyRoutedTransforms(MappedSignal& m)
+{
+    const std::string& prefix = mapKeyForInstrument(m.inst);
+    std::lock_guard<std::mutex> lock(g_mapMutex);
+    auto it = g_map.find(prefix);
+    if (it == g_map.end()) return;
+    if (applyTransforms(it->second, m.action, m.qty, m.slPoints, m.ptPoints) && !t_warmupFrame)
+        counterAdd(CNT_TRANSFORMED, 1);
+}
+
+// Decode latency per live signal frame (onFragment entry to delivery or drop).
+// The first frame after StartW is kept apart from the steady state so a cold
+// first signal, and what warm-up saves on it, shows up in the counters.
+static std::atomic<bool> g_firstDecodePending{ true };
+
+static inline void recordDecodeLatency(int64_t ns)
+{
+    if (g_firstDecodePending.load(std::memory_order_relaxed) && g_firstDecodePending.exchange(false))
+    {
+        counterSet(CNT_FIRST_DECODE_NS, ns);
+        return;
+    }
+    counterAdd(CNT_DECODE_NS_TOTAL, ns);
+    counterAdd(CNT_DECODES, 1);
+}
+
+// Routed frame: symbol and SL/PT points were resolved by the signal router
+static void onRoutedFrame(const uint8_t* buffer, int64_t receiveNs, bool tracing)
+{
+    const uint16_t action = rd_u16_le(buffer + ROUTED_ACTION_OFFSET);
+    if (!rateLimitAdmit(action, buffer + ROUTED_SOURCE_OFFSET, buffer + ROUTED_INSTRUMENT_OFFSET))
+        return;
+    if (!t_warmupFrame)
+        updateSignalState(buffer + ROUTED_SOURCE_OFFSET, buffer + ROUTED_INSTRUMENT_OFFSET, buffer + ROUTED_MT5_SYMBOL_OFFSET,
+            action, rd_i32_le(buffer + ROUTED_QTY_OFFSET), rd_i64_le(buffer + ROUTED_TIMESTAMP_OFFSET), false);
+    if (isFilteredExit(action))
+    {
+        counterAdd(CNT_EXITS_FILTERED, 1);
+        return;
+    }
+
+    const int laneId = laneForAction(action);
+    SignalMeta meta;
+    meta.publishNs = rd_i64_le(buffer + ROUTED_TIMESTAMP_OFFSET);
+    meta.receiveWallNs = wallClockNanos();
+    meta.originNs = signalOriginNs(meta.publishNs, meta.receiveWallNs);
+    meta.merged = 1;
+    if (expiredOnArrival(laneId, meta.originNs, meta.receiveWallNs))
+        return;
+
+    MappedSignal m;
+    m.action = action;
+    m.qty = rd_i32_le(buffer + ROUTED_QTY_OFFSET);
+    m.slPoints = rd_i32_le(buffer + ROUTED_SL_POINTS_OFFSET);
+    m.ptPoints = rd_i32_le(buffer + ROUTED_PT_POINTS_OFFSET);
+    m.confidence = rd_f32_le(buffer + ROUTED_CONFIDENCE_OFFSET);
+    copy_ascii_trim0(m.sym, buffer + ROUTED_SYMBOL_OFFSET, SYMBOL_LEN);
+    copy_ascii_trim0(m.mt5Symbol, buffer + ROUTED_MT5_SYMBOL_OFFSET, MT5_SYMBOL_LEN);
+    copy_ascii_trim0(m.src, buffer + ROUTED_SOURCE_OFFSET, SOURCE_LEN);
+    copy_ascii_trim0(m.inst, buffer + ROUTED_INSTRUMENT_OFFSET, INSTRUMENT_LEN);
+    if (g_transformsActive.load(std::memory_order_relaxed))
+        applyRoutedTransforms(m);
+
+    meta.signalId = t_warmupFrame ? 0 : g_nextSignalId.fetch_add(1, std::memory_order_relaxed);
+    if (tracing)
+    {
+        traceBegin(meta.signalId, receiveNs, meta.publishNs, action, m.inst);
+        traceStage(meta.signalId, TRACE_STAGE_MAPPED);
+    }
+
+    deliverMappedSignal(m, meta, tracing);
+}
+
+// Raw signal frame (already validated): filter, decode, map and deliver
+static void onSignalFrame(const uint8_t* buffer, int64_t receiveNs, bool tracing)
+{
+    const uint16_t action = rd_u16_le(buffer + ACTION_OFFSET);
+
+    // Shed floods on the raw fields, before the state table, filters or any string work
+    if (!rateLimitAdmit(action, buffer + SOURCE_OFFSET, buffer + INSTRUMENT_OFFSET))
+        return;
+
+    // Exits still move the source's state, so record before filtering
+    if (!t_warmupFrame)
+        updateSignalState(buffer + SOURCE_OFFSET, buffer + INSTRUMENT_OFFSET, nullptr,
+            action, rd_i32_le(buffer + QTY_OFFSET), rd_i64_le(buffer + TIMESTAMP_OFFSET), false);
+
+    // Ignore exits as per your requirement (5,6)
+    if (isFilteredExit(action))
+    {
+        counterAdd(CNT_EXITS_FILTERED, 1);
+        return;
+    }
+
+    // Expire stale signals before any string work
+    const int laneId = laneForAction(action);
+    SignalMeta meta;
+    meta.publishNs = rd_i64_le(buffer + TIMESTAMP_OFFSET);
+    meta.receiveWallNs = wallClockNanos();
+    meta.originNs = signalOriginNs(meta.publishNs, meta.receiveWallNs);
+    meta.merged = 1;
+    if (expiredOnArrival(laneId, meta.originNs, meta.receiveWallNs))
+        return;
+
+    const int32_t longSL = rd_i32_le(buffer + LONG_SL_OFFSET);
+    const int32_t shortSL = rd_i32_le(buffer + SHORT_SL_OFFSET);
+    const int32_t pt = rd_i32_le(buffer + PROFIT_TARGET_OFFSET);
+
+    MappedSignal m;
+    m.action = action;
+    m.qty = rd_i32_le(buffer + QTY_OFFSET);
+    m.confidence = rd_f32_le(buffer + CONFIDENCE_OFFSET);
+    copy_ascii_trim0(m.sym, buffer + SYMBOL_OFFSET, SYMBOL_LEN);
+    copy_ascii_trim0(m.inst, buffer + INSTRUMENT_OFFSET, INSTRUMENT_LEN);
+    copy_ascii_trim0(m.src, buffer + SOURCE_OFFSET, SOURCE_LEN);
+    meta.signalId = t_warmupFrame ? 0 : g_nextSignalId.fetch_add(1, std::memory_order_relaxed);
+    if (tracing)
+        traceBegin(meta.signalId, receiveNs, meta.publishNs, action, m.inst);
+
+    const int slTicks = slTicksForAction(action, longSL, shortSL);
+
+    ensureDefaultMap();
+
+    // Convert under the lock straight from the table entry (no InstMap copy)
+    const std::string& prefix = mapKeyForInstrument(m.inst);
+    bool transformed = false;
+    {
+        std::lock_guard<std::mutex> lock(g_mapMutex);
+        auto it = g_map.find(prefix);
+        if (it != g_map.end())
+        {
+            const InstMap& map = it->second;
+            m.slPoints = ticksToMt5Points(slTicks, map);
+            m.ptPoints = ticksToMt5Points(pt, map);
+            std::snprintf(m.mt5Symbol, sizeof(m.mt5Symbol), "%s", map.mt5Symbol.c_str());
+            transformed = applyTransforms(map, m.action, m.qty, m.slPoints, m.ptPoints);
+        }
+        else if (g_allowUnmapped.load())
+        {
+            // Pass-through mode: use prefix as symbol with default conversion
+            m.slPoints = ticksToPoints(slTicks, g_defaultTickSize, g_defaultPointSize);
+            m.ptPoints = ticksToPoints(pt, g_defaultTickSize, g_defaultPointSize);
+            std::snprintf(m.mt5Symbol, sizeof(m.mt5Symbol), "%s", prefix.c_str());
+        }
+        else
+        {
+            // Strict mode: reject unknown instruments (text rendered on read)
+            counterAdd(CNT_UNMAPPED_DROPS, 1);
+            recordError(ERR_UNMAPPED_INSTRUMENT, ORIGIN_SUBSCRIBER, g_subStreamId.load(std::memory_order_relaxed), m.inst, 0);
+            return;
+        }
+    }
+    if (transformed && !t_warmupFrame)
+        counterAdd(CNT_TRANSFORMED, 1);
+
+    if (tracing) traceStage(meta.signalId, TRACE_STAGE_MAPPED);
+
+    deliverMappedSignal(m, meta, tracing);
+}
+
+static void onFragment(
+    void* /*clientd*/,
+    const uint8_t* buffer,
+    size_t length,
+    aeron_header_t* header)
+{
+    // Synthetic warm-up frames are never traced
+    const bool tracing = !t_warmupFrame && g_traceEnabled.load(std::memory_order_relaxed) != 0;
+    const int64_t receiveNs = tracing ? wallClockNanos() : 0;
+
+    if (!buffer)
+    {
+        counterAdd(CNT_REJECTED_LENGTH, 1);
+        return;
+    }
+
+    if (isHeartbeatFrame(buffer, length))
+    {
+        onHeartbeat(buffer, header);
+        return;
+    }
+
+    // Market data shares the frame space but is not for the signal lanes
+    if (isQuoteFrame(buffer, length))
+        return;
+
+    if (isStateFrame(buffer, length))
+    {
+        onStateSnapshot(buffer);
+        return;
+    }
+
+    const int64_t decodeStartNs = t_warmupFrame ? 0 : steadyNanos();
+
+    // Pre-mapped frame from the signal router: skip mapping
+    if (isRoutedFrame(buffer, length))
+    {
+        onRoutedFrame(buffer, receiveNs, tracing);
+    }
+    else
+    {
+        // Validate length + MAGIC + VERSION
+        switch (checkSignalFrame(buffer, length))
+        {
+        case FRAME_BAD_LENGTH:  counterAdd(CNT_REJECTED_LENGTH, 1);  return;
+        case FRAME_BAD_MAGIC:   counterAdd(CNT_REJECTED_MAGIC, 1);   return;
+        case FRAME_BAD_VERSION: counterAdd(CNT_REJECTED_VERSION, 1); return;
+        default: break;
+        }
+        onSignalFrame(buffer, receiveNs, tracing);
+    }
+
+    if (!t_warmupFrame)
+        recordDecodeLatency(steadyNanos() - decodeStartNs);
+}
+
+// ===============================
+// Start-up warm-up
+// ===============================
+// Optional (AeronBridge_SetWarmup). The client pre-touches every log buffer it
+// maps, and StartW pushes synthetic raw and routed frames through onFragment so
+// decode, mapping, transforms and the lane slots are hot before the first live
+// signal. Synthetic frames run with t_warmupFrame set: they skip rate limits,
+// netting, signal ids, tracing and the decode latency counters, and reach the
+// lanes as uncommitted slot writes only.
+static void warmUpDecodePath(int frames)
+{
+    ensureDefaultMap();
+
+    std::string prefix = "ES";
+    InstMap map{ "SPX500", 0.25, 0.1 };
+    {
+        std::lock_guard<std::mutex> lock(g_mapMutex);
+        g_map.reserve(64);
+        if (!g_map.empty())
+        {
+            prefix = g_map.begin()->first;
+            map = g_map.begin()->second;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_imageMutex);
+        g_images.reserve(16);
+    }
+
+    uint8_t raw[FRAME_SIZE] = {};
+    uint8_t routed[ROUTED_FRAME_SIZE] = {};
+    const std::string inst = prefix + " WARMUP";
+    wr_u32_le(raw + MAGIC_OFFSET, MAGIC);
+    wr_u16_le(raw + VERSION_OFFSET, VERSION);
+    wr_i32_le(raw + LONG_SL_OFFSET, 8);
+    wr_i32_le(raw + SHORT_SL_OFFSET, 8);
+    wr_i32_le(raw + PROFIT_TARGET_OFFSET, 16);
+    wr_i32_le(raw + QTY_OFFSET, 1);
+    write_ascii_pad0(raw + SYMBOL_OFFSET, prefix.c_str(), SYMBOL_LEN);
+    write_ascii_pad0(raw + INSTRUMENT_OFFSET, inst.c_str(), INSTRUMENT_LEN);
+    write_ascii_pad0(raw + SOURCE_OFFSET, "WARMUP", SOURCE_LEN);
+
+    t_warmupFrame = true;
+    for (int i = 0; i < frames; i++)
+    {
+        // Entries only: exits are filtered before the hot part of the path
+        wr_u16_le(raw + ACTION_OFFSET, (uint16_t)((i & 1) ? 3 : 1));
+        wr_i64_le(raw + TIMESTAMP_OFFSET, wallClockNanos());
+        if (i % 4 == 3)
+        {
+            encodeRoutedFrame(routed, raw, map);
+            onFragment(nullptr, routed, ROUTED_FRAME_SIZE, nullptr);
+        }
+        else
+        {
+            onFragment(nullptr, raw, FRAME_SIZE, nullptr);
+        }
+    }
+    t_warmupFrame = false;
+    counterAdd(CNT_WARMUP_FRAMES, frames);
+}
+
+// Subscribe async + timeout. Returns null on failure (error set).
+static aeron_subscription_t* addSubscription(const std::string& channel, int streamId, int timeoutMs)
+{
+    aeron_async_add_subscription_t* asyncSub = nullptr;
+    if (aeron_async_add_subscription(
+        &asyncSub,
+        g_aeron,
+        channel.c_str(),
+        streamId,
+        onAvailableImage, nullptr,
+        onUnavailableImage, nullptr) < 0)
+    {
+        setErrorFromAeron("aeron_async_add_subscription failed");
+        return nullptr;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    aeron_subscription_t* subscription = nullptr;
+    while (true)
+    {
+        const int pollRes = aeron_async_add_subscription_poll(&subscription, asyncSub);
+        if (pollRes < 0)
+        {
+            setErrorFromAeron("aeron_async_add_subscription_poll failed");
+            return nullptr;
+        }
+        if (pollRes > 0)
+        {
+            // Ready
+            return subscription;
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            setError("Subscribe timeout: MediaDriver down or channel/stream mismatch (stream " + std::to_string(streamId) + ")");
+            return nullptr;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// ===============================
+// Exported API
+// ===============================
+int AeronBridge_StartW(const wchar_t* aeronDirW, const wchar_t* channelW, int streamId, int timeoutMs)
+{
+    if (g_started.load()) return 1;
+
+    const std::string aeronDir = wide_to_utf8(aeronDirW);
+    const std::string channel = wide_to_utf8(channelW);
+
+    if (!channelLooksValid(channel))
+    {
+        setError("Invalid Aeron channel: must start with 'aeron:'");
+        return 0;
+    }
+    if (streamId <= 0)
+    {
+        setError("Invalid streamId: must be > 0");
+        return 0;
+    }
+    if (timeoutMs <= 0) timeoutMs = 3000;
+
+    ensureDefaultMap();
+
+    if (g_persistEnabled.load() && g_persistSegment)
+    {
+        std::lock_guard<std::mutex> lock(g_sigMutex);
+        restoreSignalsLocked(g_persistSegment, channel, streamId);
+    }
+
+    if (aeron_context_init(&g_context) < 0)
+    {
+        setErrorFromAeron("aeron_context_init failed");
+        return 0;
+    }
+
+    if (!aeronDir.empty())
+    {
+        aeron_context_set_dir(g_context, aeronDir.c_str());
+    }
+    if (g_warmupFrames.load() > 0)
+        aeron_context_set_pre_touch_mapped_memory(g_context, true);
+
+    if (aeron_init(&g_aeron, g_context) < 0)
+    {
+        setErrorFromAeron("aeron_init failed");
+        return 0;
+    }
+
+    if (aeron_start(g_aeron) < 0)
+    {
+        setErrorFromAeron("aeron_start failed");
+        return 0;
+    }
+
+    registerBridgeCounters();
+
+    // One subscription per shard stream covering the mappings (just streamId
+    // while sharding is off); the first is g_subscription
+    const std::vector<int> streams = subscribedStreams(streamId);
+    for (size_t i = 0; i < streams.size(); i++)
+    {
+        aeron_subscription_t* subscription = addSubscription(channel, streams[i], timeoutMs);
+        if (!subscription)
+        {
+            closeSignalSubscriptions();
+            return 0;
+        }
+        if (i == 0)
+            g_subscription = subscription;
+        else
+            g_shardSubscriptions.push_back(subscription);
+    }
+
+    g_subStreamId.store(streamId);
+    {
+        std::lock_guard<std::mutex> lock(g_subStreamsMutex);
+        g_subStreams = streams;
+    }
+    g_subChannel = channel;
+
+    const int warmupFrames = g_warmupFrames.load();
+    if (warmupFrames > 0) warmUpDecodePath(warmupFrames);
+    g_firstDecodePending.store(true);
+
+    g_started.store(1);
+    return 1;
+}
+
+int AeronBridge_SetWarmup(int syntheticFrames)
+{
+    // Pre-touch is a context setting: it only reaches a client created after this call
+    if (g_aeron)
+    {
+        setError("SetWarmup: Aeron client already running; call SetWarmup before the first Start");
+        return 0;
+    }
+    if (syntheticFrames < 0) syntheticFrames = 0;
+    if (syntheticFrames > 100000) syntheticFrames = 100000;
+    g_warmupFrames.store(syntheticFrames);
+    return 1;
+}
+
+int AeronBridge_SetShardMapW(const wchar_t* shardMapW)
+{
+    std::unique_ptr<ShardMap> map(new ShardMap());
+    std::string err;
+    if (!compileShardMap(wide_to_utf8(shardMapW), map->routes, &map->routeCount, &map->defaultStream, &err))
+    {
+        setError("SetShardMap: " + err);
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(g_shardMutex);
+    if (map->routeCount == 0 && map->defaultStream == 0)
+    {
+        g_shardMap.store(nullptr, std::memory_order_release);
+        return 1;
+    }
+    g_shardMap.store(map.get(), std::memory_order_release);
+    g_shardMaps.push_back(std::move(map));
+    return 1;
+}
+
+int AeronBridge_GetSubscribedStreams(unsigned char* outBuf, int outBufLen)
+{
+    if (!outBuf || outBufLen <= 1) return 0;
+    outBuf[0] = 0;
+
+    // Comma-separated stream ids, first = the primary subscription
+    std::lock_guard<std::mutex> lock(g_subStreamsMutex);
+    int written = 0;
+    char item[16];
+    for (int streamId : g_subStreams)
+    {
+        const int n = std::snprintf(item, sizeof(item), written ? ",%d" : "%d", streamId);
+        if (n <= 0 || written + n >= outBufLen) break;
+        std::memcpy(outBuf + written, item, (size_t)n);
+        written += n;
+        outBuf[written] = 0;
+    }
+    return written;
+}
+
+int AeronBridge_RegisterInstrumentMapW(
+    const wchar_t* futPrefixW,
+    const wchar_t* mt5SymbolW,
+    double futTickSize,
+    double mt5PointSize)
+{
+    const std::string futPrefix = wide_to_utf8(futPrefixW);
+    const std::string mt5Symbol = wide_to_utf8(mt5SymbolW);
+
+    if (futPrefix.empty() || mt5Symbol.empty())
+    {
+        setError("RegisterInstrumentMap: futPrefix/mt5Symbol cannot be empty");
+        return 0;
+    }
+    if (futTickSize <= 0.0 || mt5PointSize <= 0.0)
+    {
+        setError("RegisterInstrumentMap: tick/point sizes must be > 0");
+        return 0;
+    }
+
+    {
+        // Re-registering keeps any transforms already set for the prefix
+        std::lock_guard<std::mutex> lock(g_mapMutex);
+        InstMap& map = g_map[futPrefix];
+        map.mt5Symbol = mt5Symbol;
+        map.futTickSize = futTickSize;
+        map.mt5PointSize = mt5PointSize;
+        if (std::find(g_registeredPrefixes.begin(), g_registeredPrefixes.end(), futPrefix) == g_registeredPrefixes.end())
+            g_registeredPrefixes.push_back(futPrefix);
+    }
+
+    return 1;
+}
+
+// Caller holds g_mapMutex
+static void refreshTransformsActiveLocked()
+{
+    int active = 0;
+    for (const auto& kv : g_map)
+    {
+        if (hasTransforms(kv.second)) { active = 1; break; }
+    }
+    g_transformsActive.store(active, std::memory_order_relaxed);
+}
+
+int AeronBridge_SetMappingTransformW(
+    const wchar_t* futPrefixW,
+    double qtyMultiplier,
+    int qtyRounding,
+    int minSlPoints,
+    int maxSlPoints,
+    int minPtPoints,
+    int maxPtPoints,
+    int reverse)
+{
+    const std::string futPrefix = wide_to_utf8(futPrefixW);
+    if (qtyMultiplier <= 0.0)
+    {
+        setError("SetMappingTransform: qtyMultiplier must be > 0");
+        return 0;
+    }
+    if (qtyRounding < QTY_ROUND_NEAREST || qtyRounding > QTY_ROUND_UP)
+    {
+        setError("SetMappingTransform: qtyRounding must be 0 (nearest), 1 (down) or 2 (up)");
+        return 0;
+    }
+    if (minSlPoints < 0 || maxSlPoints < 0 || minPtPoints < 0 || maxPtPoints < 0 ||
+        (maxSlPoints > 0 && minSlPoints > maxSlPoints) ||
+        (maxPtPoints > 0 && minPtPoints > maxPtPoints))
+    {
+        setError("SetMappingTransform: SL/PT limits must be >= 0 and min <= max");
+        return 0;
+    }
+
+    ensureDefaultMap();
+
+    std::lock_guard<std::mutex> lock(g_mapMutex);
+    const bool all = futPrefix == "*";
+    if (!all && g_map.find(futPrefix) == g_map.end())
+    {
+        setError("SetMappingTransform: no mapping for '" + futPrefix + "'; register it first");
+        return 0;
+    }
+    for (auto& kv : g_map)
+    {
+        if (!all && kv.first != futPrefix) continue;
+        InstMap& map = kv.second;
+        map.qtyMultiplier = qtyMultiplier;
+        map.qtyRounding = qtyRounding;
+        map.minSlPoints = minSlPoints;
+        map.maxSlPoints = maxSlPoints;
+        map.minPtPoints = minPtPoints;
+        map.maxPtPoints = maxPtPoints;
+        map.reverse = reverse != 0;
+    }
+    refreshTransformsActiveLocked();
+    return 1;
+}
+
+int AeronBridge_SetActionRemapW(const wchar_t* futPrefixW, int fromAction, int toAction)
+{
+    const std::string futPrefix = wide_to_utf8(futPrefixW);
+    if (fromAction < 1 || fromAction >= ACTION_MAP_SIZE || toAction < 0 || toAction >= ACTION_MAP_SIZE)
+    {
+        setError("SetActionRemap: actions must be 1..10 (toAction 0 clears)");
+        return 0;
+    }
+
+    ensureDefaultMap();
+
+    std::lock_guard<std::mutex> lock(g_mapMutex);
+    const bool all = futPrefix == "*";
+    if (!all && g_map.find(futPrefix) == g_map.end())
+    {
+        setError("SetActionRemap: no mapping for '" + futPrefix + "'; register it first");
+        return 0;
+    }
+    for (auto& kv : g_map)
+    {
+        if (all || kv.first == futPrefix)
+            kv.second.actionMap[fromAction] = (uint8_t)toAction;
+    }
+    refreshTransformsActiveLocked();
+    return 1;
+}
+
+// Shared poll accounting. saturated: more was waiting than this call consumed.
+static void afterPoll(int fragments, bool saturated)
+{
+    if (fragments > 0) counterAdd(CNT_FRAGMENTS_POLLED, fragments);
+
+    // Sample lag when we fell behind, otherwise every 64th poll
+    static thread_local uint32_t pollCount = 0;
+    if (saturated)
+    {
+        counterAdd(CNT_POLLS_SATURATED, 1);
+        sampleImageLag();
+    }
+    else if ((++pollCount & 63) == 0)
+    {
+        sampleImageLag();
+    }
+
+    // Netting windows close on time even while nobody reads the queue
+    flushDueNetting();
+    checkLiveness();
+}
+
+// Signal subscriptions: g_subscription, then one per extra shard stream
+static inline int subscriptionCount()
+{
+    return g_subscription ? 1 + (int)g_shardSubscriptions.size() : 0;
+}
+
+static inline aeron_subscription_t* subscriptionAt(int i)
+{
+    return i == 0 ? g_subscription : g_shardSubscriptions[(size_t)i - 1];
+}
+
+int AeronBridge_Poll()
+{
+    const int count = subscriptionCount();
+    if (count == 0) return 0;
+
+    const int limit = 10;
+    int fragments = 0;
+    if (count == 1)
+    {
+        fragments = (int)aeron_subscription_poll(g_subscription, onFragment, nullptr, limit);
+    }
+    else
+    {
+        // Rotate the first shard so a busy one cannot starve the others
+        static thread_local int first = 0;
+        first = (first + 1) % count;
+        for (int i = 0; i < count && fragments < limit; i++)
+        {
+            const int n = (int)aeron_subscription_poll(subscriptionAt((first + i) % count), onFragment, nullptr, (size_t)(limit - fragments));
+            if (n > 0) fragments += n;
+        }
+    }
+    afterPoll(fragments, fragments >= limit);
+    return fragments;
+}
+
+// PollBudget: controlled poll that leaves fragments in the term buffer when the
+// time budget is spent or the signal queue is full, instead of dropping them.
+// The final lane is only known after mapping, transforms and session conversion,
+// so any full lane stops the poll before a signal frame is decoded: nothing is
+// touched (state table, rate tokens, signal ids) and the frame is redelivered
+// once the EA has drained. Heartbeat, quote and state frames still flow.
+enum PollStopReason
+{
+    POLL_STOP_NONE = 0,       // fragment limit reached or nothing left
+    POLL_STOP_TIME = 1,       // maxMicros used up
+    POLL_STOP_QUEUE_FULL = 2  // a lane is full; fragment left for the next call
+};
+
+enum PollStat
+{
+    POLL_STAT_FRAGMENTS = 0,
+    POLL_STAT_ENQUEUED,
+    POLL_STAT_STOP_REASON,
+    POLL_STAT_ELAPSED_US,
+    POLL_STAT_DROPPED,
+    POLL_STAT_COUNT
+};
+
+struct PollBudgetState
+{
+    std::chrono::steady_clock::time_point start;
+    int64_t maxNanos;    // 0 = no time budget
+    int stopReason;
+};
+
+static thread_local int64_t t_lastPollStats[POLL_STAT_COUNT];
+
+// Whether the fragment is a signal frame and some lane has no free slot
+static bool signalQueueFull(const uint8_t* buffer, size_t length)
+{
+    if (!buffer || (!isRoutedFrame(buffer, length) && checkSignalFrame(buffer, length) != FRAME_OK))
+        return false;
+
+    std::lock_guard<std::mutex> lock(g_sigMutex);
+    for (int i = 0; i < LANE_COUNT; i++)
+    {
+        const SignalLane& lane = g_lanes[i];
+        if (lane.count >= lane.slots.size()) return true;
+    }
+    return false;
+}
+
+static aeron_controlled_fragment_handler_action_t onControlledFragment(
+    void* clientd,
+    const uint8_t* buffer,
+    size_t length,
+    aeron_header_t* header)
+{
+    PollBudgetState* st = (PollBudgetState*)clientd;
+    if (st->stopReason != POLL_STOP_NONE)
+        return AERON_ACTION_ABORT;  // stopped on another image: leave the rest in place
+
+    if (st->maxNanos > 0)
+    {
+        const int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - st->start).count();
+        if (elapsed >= st->maxNanos)
+        {
+            st->stopReason = POLL_STOP_TIME;
+            return AERON_ACTION_ABORT;
+        }
+    }
+
+    if (signalQueueFull(buffer, length))
+    {
+        st->stopReason = POLL_STOP_QUEUE_FULL;
+        return AERON_ACTION_ABORT;
+    }
+
+    onFragment(nullptr, buffer, length, header);
+    return AERON_ACTION_CONTINUE;
+}
+
+int AeronBridge_PollBudget(int maxFragments, int maxMicros)
+{
+    for (int i = 0; i < POLL_STAT_COUNT; i++) t_lastPollStats[i] = 0;
+    if (!g_subscription) return 0;
+    if (maxFragments <= 0) maxFragments = 10;
+    if (maxMicros < 0) maxMicros = 0;
+
+    PollBudgetState st;
+    st.start = std::chrono::steady_clock::now();
+    st.maxNanos = (int64_t)maxMicros * 1000;
+    st.stopReason = POLL_STOP_NONE;
+
+    const int64_t enqueuedBefore = t_enqueuedThisThread;
+    const int64_t droppedBefore = t_droppedThisThread;
+    const int count = subscriptionCount();
+    int fragments = 0;
+    static thread_local int first = 0;
+    first = (first + 1) % count;
+    for (int i = 0; i < count && fragments < maxFragments && st.stopReason == POLL_STOP_NONE; i++)
+    {
+        const int n = (int)aeron_subscription_controlled_poll(
+            subscriptionAt((first + i) % count),
+            onControlledFragment,
+            &st,
+            (size_t)(maxFragments - fragments));
+        if (n > 0) fragments += n;
+    }
+    afterPoll(fragments, fragments >= maxFragments || st.stopReason != POLL_STOP_NONE);
+
+    t_lastPollStats[POLL_STAT_FRAGMENTS] = fragments > 0 ? fragments : 0;
+    t_lastPollStats[POLL_STAT_ENQUEUED] = t_enqueuedThisThread - enqueuedBefore;
+    t_lastPollStats[POLL_STAT_STOP_REASON] = st.stopReason;
+    t_lastPollStats[POLL_STAT_ELAPSED_US] = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - st.start).count();
+    t_lastPollStats[POLL_STAT_DROPPED] = t_droppedThisThread - droppedBefore;
+    return fragments;
+}
+
+long long AeronBridge_LastPollStat(int stat)
+{
+    if (stat < 0 || stat >= POLL_STAT_COUNT) return 0;
+    return (long long)t_lastPollStats[stat];
+}
+
+int AeronBridge_GetImageStats(unsigned char* outBuf, int outBufLen)
+{
+    if (!outBuf || outBufLen <= 1) return 0;
+    outBuf[0] = 0;
+
+    sampleImageLag();
+
+    // CSV per line: session_id,source,correlation_id,active,join_ns,leave_ns,join_position,
+    // position,lag,max_lag,rejoins,end_of_stream
+    std::lock_guard<std::mutex> lock(g_imageMutex);
+    int written = 0;
+    char line[256];
+    for (const auto& r : g_images)
+    {
+        const int n = std::snprintf(line, sizeof(line), "%d,%s,%lld,%d,%lld,%lld,%lld,%lld,%lld,%lld,%d,%d\n",
+            (int)r.sessionId, r.source, (long long)r.correlationId, r.leaveNs == 0 ? 1 : 0,
+            (long long)r.joinNs, (long long)r.leaveNs, (long long)r.joinPosition,
+            (long long)r.lastPosition, (long long)(r.publisherPositionId < 0 ? -1 : r.lastLag),
+            (long long)r.maxLag, (int)r.rejoins, (int)r.endOfStream);
+        if (n <= 0 || written + n >= outBufLen) break;
+        std::memcpy(outBuf + written, line, (size_t)n);
+        written += n;
+        outBuf[written] = 0;
+    }
+    return written;
+}
+
+int AeronBridge_SetLivenessTimeout(int timeoutMs)
+{
+    if (timeoutMs < 0)
+    {
+        setError("SetLivenessTimeout: timeoutMs must be >= 0");
+        return 0;
+    }
+    g_livenessTimeoutNs.store((int64_t)timeoutMs * 1000000);
+    return 1;
+}
+
+int AeronBridge_GetLiveness(unsigned char* outBuf, int outBufLen)
+{
+    if (!outBuf || outBufLen <= 1) return 0;
+    outBuf[0] = 0;
+
+    const int64_t nowNs = wallClockNanos();
+    std::lock_guard<std::mutex> lock(g_livenessMutex);
+    checkLivenessLocked(nowNs);
+
+    // CSV per line: source,session_id,alive,age_ms,interval_ms,beats,missed,stale_events,last_sender_ns
+    int written = 0;
+    char line[192];
+    const int count = g_livenessCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; i++)
+    {
+        const SourceLiveness& r = g_liveness[i];
+        const int n = std::snprintf(line, sizeof(line), "%s,%d,%d,%lld,%d,%lld,%lld,%d,%lld\n",
+            r.source, (int)r.sessionId, r.stale ? 0 : 1, (long long)((nowNs - r.lastSeenNs) / 1000000),
+            (int)r.intervalMs, (long long)r.beats, (long long)r.missed, (int)r.staleEvents,
+            (long long)r.lastSenderNs);
+        if (n <= 0 || written + n >= outBufLen) break;
+        std::memcpy(outBuf + written, line, (size_t)n);
+        written += n;
+        outBuf[written] = 0;
+    }
+    return written;
+}
+
+int AeronBridge_IsSourceAliveW(const wchar_t* source)
+{
+    const std::string name = wide_to_utf8(source);
+    const int64_t nowNs = wallClockNanos();
+
+    std::lock_guard<std::mutex> lock(g_livenessMutex);
+    checkLivenessLocked(nowNs);
+
+    int result = -1;
+    const int count = g_livenessCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; i++)
+    {
+        if (name != g_liveness[i].source) continue;
+        if (!g_liveness[i].stale) return 1;  // any live session counts
+        result = 0;
+    }
+    return result;
+}
+
+int AeronBridge_SetRateLimitW(int scope, const wchar_t* key, double ratePerSec, int burst)
+{
+    if (scope < 0 || scope >= RATE_SCOPE_COUNT)
+    {
+        setError("SetRateLimit: scope must be 0 (source) or 1 (instrument)");
+        return 0;
+    }
+    if (ratePerSec < 0.0 || burst < 0)
+    {
+        setError("SetRateLimit: ratePerSec and burst must be >= 0");
+        return 0;
+    }
+
+    const std::string k = wide_to_utf8(key);
+    const int keyLen = scope == RATE_SCOPE_SOURCE ? SOURCE_LEN : INSTRUMENT_LEN;
+    if ((int)k.size() > keyLen)
+    {
+        setError("SetRateLimit: key longer than the frame field");
+        return 0;
+    }
+    const double capacity = burst > 0 ? (double)burst : (ratePerSec > 1.0 ? ratePerSec : 1.0);
+
+    std::lock_guard<std::mutex> lock(g_rateMutex);
+    if (k.empty())
+    {
+        // Scope default: applies to buckets created from it from now on
+        g_rateDefaults[scope] = RateDefault{ ratePerSec, capacity };
+        for (int i = 0; i < g_rateBucketCount; i++)
+        {
+            RateBucket& b = g_rateBuckets[i];
+            if (b.scope != scope || b.configured) continue;
+            b.ratePerSec = ratePerSec;
+            b.burst = capacity;
+            if (b.tokens > capacity) b.tokens = capacity;
+        }
+        RateBucket& o = g_rateOverflow[scope];
+        o.ratePerSec = ratePerSec;
+        o.burst = capacity;
+        if (o.tokens > capacity) o.tokens = capacity;
+    }
+    else
+    {
+        RateBucket* b = nullptr;
+        for (int i = 0; i < g_rateBucketCount && !b; i++)
+        {
+            if (g_rateBuckets[i].scope == scope && k == g_rateBuckets[i].key) b = &g_rateBuckets[i];
+        }
+        if (!b)
+        {
+            if (g_rateBucketCount >= MAX_RATE_BUCKETS)
+            {
+                setError("SetRateLimit: too many rate limit keys");
+                return 0;
+            }
+            b = &g_rateBuckets[g_rateBucketCount++];
+            *b = RateBucket{};
+            b->scope = scope;
+            std::snprintf(b->key, sizeof(b->key), "%s", k.c_str());
+            b->tokens = capacity;
+            b->lastNs = steadyNanos();
+        }
+        b->configured = true;
+        b->ratePerSec = ratePerSec;
+        b->burst = capacity;
+        if (b->tokens > capacity) b->tokens = capacity;
+    }
+
+    // Keyed buckets with rate 0 stay in the table as explicit "unlimited"
+    int active = 0;
+    for (int s = 0; s < RATE_SCOPE_COUNT; s++)
+        if (g_rateDefaults[s].ratePerSec > 0.0) active = 1;
+    for (int i = 0; i < g_rateBucketCount && !active; i++)
+        if (g_rateBuckets[i].ratePerSec > 0.0) active = 1;
+    g_rateLimitsActive.store(active);
+    return 1;
+}
+
+int AeronBridge_GetRateLimitStats(unsigned char* outBuf, int outBufLen)
+{
+    if (!outBuf || outBufLen <= 1) return 0;
+    outBuf[0] = 0;
+
+    const int64_t nowNs = steadyNanos();
+    std::lock_guard<std::mutex> lock(g_rateMutex);
+
+    // CSV per line: scope,key,rate_per_sec,burst,tokens,passed,shed,alarm
+    // (keyed buckets, then the overflow buckets that have been used)
+    int written = 0;
+    char line[192];
+    for (int i = 0; i < g_rateBucketCount + RATE_SCOPE_COUNT; i++)
+    {
+        RateBucket& b = i < g_rateBucketCount ? g_rateBuckets[i] : g_rateOverflow[i - g_rateBucketCount];
+        if (i >= g_rateBucketCount && b.lastNs == 0) continue;
+        if (b.ratePerSec > 0.0) refillBucket(b, nowNs);
+        const int n = std::snprintf(line, sizeof(line), "%d,%s,%.2f,%.0f,%.2f,%lld,%lld,%d\n",
+            b.scope, b.key, b.ratePerSec, b.burst, b.tokens,
+            (long long)b.passed, (long long)b.shed, b.alarm ? 1 : 0);
+        if (n <= 0 || written + n >= outBufLen) break;
+        std::memcpy(outBuf + written, line, (size_t)n);
+        written += n;
+        outBuf[written] = 0;
+    }
+    return written;
+}
+
+int AeronBridge_ClearRateAlarms()
+{
+    int cleared = 0;
+    std::lock_guard<std::mutex> lock(g_rateMutex);
+    for (int i = 0; i < g_rateBucketCount; i++)
+    {
+        if (g_rateBuckets[i].alarm) cleared++;
+        g_rateBuckets[i].alarm = false;
+    }
+    for (RateBucket& o : g_rateOverflow)
+    {
+        if (o.alarm) cleared++;
+        o.alarm = false;
+    }
+    return cleared;
+}
+
+int AeronBridge_SetSessionCalendarW(
+    const wchar_t* futPrefixW,
+    const wchar_t* scheduleW,
+    int utcOffsetMinutes,
+    int closeBufferMinutes,
+    int nearClosePolicy)
+{
+    const std::string futPrefix = wide_to_utf8(futPrefixW);
+    const std::string schedule = wide_to_utf8(scheduleW);
+    if (futPrefix.empty() || futPrefix.size() > (size_t)SYMBOL_LEN)
+    {
+        setError("SetSessionCalendar: futPrefix must be 1-16 characters");
+        return 0;
+    }
+    if (utcOffsetMinutes < -14 * 60 || utcOffsetMinutes > 14 * 60 || closeBufferMinutes < 0 ||
+        (nearClosePolicy != SESSION_NEAR_CLOSE_GATE && nearClosePolicy != SESSION_NEAR_CLOSE_FORCE_EXIT))
+    {
+        setError("SetSessionCalendar: utcOffsetMinutes must be within +/-14h, closeBufferMinutes >= 0, policy 0 (gate) or 1 (force exit)");
+        return 0;
+    }
+
+    SessionCalendar compiled{};
+    if (!schedule.empty())
+    {
+        std::string err;
+        if (!compileSessionCalendar(schedule, utcOffsetMinutes, compiled, &err))
+        {
+            setError("SetSessionCalendar: " + err);
+            return 0;
+        }
+    }
+    std::snprintf(compiled.prefix, sizeof(compiled.prefix), "%s", futPrefix.c_str());
+    compiled.closeBufferMin = closeBufferMinutes;
+    compiled.nearClosePolicy = nearClosePolicy;
+
+    std::lock_guard<std::mutex> lock(g_sessionMutex);
+    SessionCalendar* c = findSessionLocked(compiled.prefix);
+    if (schedule.empty())
+    {
+        // Empty schedule removes the calendar (no gating for the prefix)
+        if (c)
+        {
+            *c = g_sessions[g_sessionCount - 1];
+            g_sessionCount--;
+        }
+    }
+    else if (c)
+    {
+        // Keep the stats across a reload
+        compiled.gated = c->gated;
+        compiled.converted = c->converted;
+        *c = compiled;
+    }
+    else
+    {
+        if (g_sessionCount >= MAX_SESSION_CALENDARS)
+        {
+            setError("SetSessionCalendar: calendar table full (" + std::to_string(MAX_SESSION_CALENDARS) + " instruments)");
+            return 0;
+        }
+        g_sessions[g_sessionCount++] = compiled;
+    }
+    g_sessionsActive.store(g_sessionCount > 0 ? 1 : 0);
+    return 1;
+}
+
+int AeronBridge_IsInSessionW(const wchar_t* futPrefixW)
+{
+    const std::string futPrefix = wide_to_utf8(futPrefixW);
+    std::lock_guard<std::mutex> lock(g_sessionMutex);
+    const SessionCalendar* c = findSessionLocked(futPrefix.c_str());
+    if (!c) return -1;
+    return sessionMinutesToClose(*c, minuteOfWeekUtc(wallClockNanos())) >= 0 ? 1 : 0;
+}
+
+int AeronBridge_GetSessionStats(unsigned char* outBuf, int outBufLen)
+{
+    if (!outBuf || outBufLen <= 1) return 0;
+    outBuf[0] = 0;
+
+    const int minute = minuteOfWeekUtc(wallClockNanos());
+    std::lock_guard<std::mutex> lock(g_sessionMutex);
+
+    // CSV per line: prefix,windows,in_session,minutes_to_close,close_buffer_min,policy,gated,converted
+    int written = 0;
+    char line[160];
+    for (int i = 0; i < g_sessionCount; i++)
+    {
+        const SessionCalendar& c = g_sessions[i];
+        const int toClose = sessionMinutesToClose(c, minute);
+        const int n = std::snprintf(line, sizeof(line), "%s,%d,%d,%d,%d,%d,%lld,%lld\n",
+            c.prefix, c.windowCount, toClose >= 0 ? 1 : 0, toClose, c.closeBufferMin, c.nearClosePolicy,
+            (long long)c.gated, (long long)c.converted);
+        if (n <= 0 || written + n >= outBufLen) break;
+        std::memcpy(outBuf + written, line, (size_t)n);
+        written += n;
+        outBuf[written] = 0;
+    }
+    return written;
+}
+
+int AeronBridge_GetSignalState(unsigned char* outBuf, int outBufLen)
+{
+    if (!outBuf || outBufLen <= 1) return 0;
+    outBuf[0] = 0;
+
+    // Copy out first: the MT5 columns are resolved under g_mapMutex
+    std::vector<SignalState> states;
+    {
+        std::lock_guard<std::mutex> lock(g_stateMutex);
+        states.assign(g_states, g_states + g_stateCount);
+    }
+    ensureDefaultMap();
+    std::lock_guard<std::mutex> lock(g_mapMutex);
+
+    // CSV per line: source,instrument,last_action,last_ns,entry_action,entry_qty,entry_ns,
+    //               direction,mt5_symbol,mt5_direction,mt5_qty,frames,seeded
+    int written = 0;
+    char line[256];
+    for (const SignalState& s : states)
+    {
+        const char* mt5Symbol = s.mt5Symbol;
+        int32_t mt5Direction = s.direction;
+        int32_t mt5Qty = s.direction != 0 ? s.entryQty : 0;
+        auto it = g_map.find(mapKeyForInstrument(s.instrument));
+        if (it != g_map.end())
+        {
+            if (!mt5Symbol[0]) mt5Symbol = it->second.mt5Symbol.c_str();
+            if (s.direction != 0)
+            {
+                // What this terminal's transforms make of the source's position
+                uint16_t action = s.entryAction;
+                int32_t sl = 0, pt = 0;
+                applyTransforms(it->second, action, mt5Qty, sl, pt);
+                mt5Direction = directionAfter(0, action);
+                if (mt5Direction == 0) mt5Qty = 0;
+            }
+        }
+
+        const int n = std::snprintf(line, sizeof(line), "%s,%s,%d,%lld,%d,%d,%lld,%d,%s,%d,%d,%lld,%d\n",
+            s.source, s.instrument, (int)s.lastAction, (long long)s.lastNs,
+            (int)s.entryAction, (int)s.entryQty, (long long)s.entryNs, (int)s.direction,
+            mt5Symbol, (int)mt5Direction, (int)mt5Qty, (long long)s.frames, s.seeded ? 1 : 0);
+        if (n <= 0 || written + n >= outBufLen) break;
+        std::memcpy(outBuf + written, line, (size_t)n);
+        written += n;
+        outBuf[written] = 0;
+    }
+    return written;
+}
+
+int AeronBridge_HasSignal()
+{
+    std::lock_guard<std::mutex> lock(g_sigMutex);
+    int laneId = 0;
+    return peekSignalLocked(&laneId) ? 1 : 0;
+}
+
+int AeronBridge_GetSignalCsv(unsigned char* outBuf, int outBufLen)
+{
+    if (!outBuf || outBufLen <= 1) return 0;
+
+    std::lock_guard<std::mutex> lock(g_sigMutex);
+    int laneId = 0;
+    const QueuedSignal* sig = peekSignalLocked(&laneId);
+    if (!sig) return 0;
+
+    const int n = sig->csvLen;
+    const int copyN = (n >= outBufLen) ? (outBufLen - 1) : n;
+
+    std::memcpy(outBuf, sig->csv, (size_t)copyN);
+    outBuf[copyN] = 0;
+
+    t_lastSignalId = sig->signalId;
+    t_lastSignalMerged = sig->merged;
+    counterAdd(CNT_SIGNALS_DELIVERED, 1);
+    if (g_traceEnabled.load(std::memory_order_relaxed))
+        traceStage(sig->signalId, TRACE_STAGE_DEQUEUED);
+
+    popSignalLocked(laneId);  // Remove from queue after reading
+    return copyN;
+}
+
+int AeronBridge_RegisterConsumerW(const wchar_t* nameW, int lapPolicy)
+{
+    const std::string name = wide_to_utf8(nameW);
+    if (name.empty() || name.size() >= (size_t)CONSUMER_NAME_LEN)
+    {
+        setError("RegisterConsumer: name must be 1-31 characters");
+        return 0;
+    }
+    if (lapPolicy != LAP_OLDEST && lapPolicy != LAP_NEWEST)
+    {
+        setError("RegisterConsumer: lapPolicy must be 0 (resume oldest) or 1 (resume newest)");
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(g_consumerMutex);
+    int freeSlot = -1;
+    for (int i = 0; i < MAX_BCAST_CONSUMERS; i++)
+    {
+        BroadcastConsumer& c = g_consumers[i];
+        if (!c.active.load())
+        {
+            if (freeSlot < 0) freeSlot = i;
+            continue;
+        }
+        if (name == c.name)
+        {
+            c.lapPolicy = lapPolicy;  // EA reload: keep the cursor
+            return i + 1;
+        }
+    }
+    if (freeSlot < 0)
+    {
+        setError("RegisterConsumer: all 16 consumer slots in use");
+        return 0;
+    }
+
+    // New consumers start with the next signal
+    BroadcastConsumer& c = g_consumers[freeSlot];
+    std::memcpy(c.name, name.c_str(), name.size() + 1);
+    c.lapPolicy = lapPolicy;
+    c.delivered.store(0);
+    c.lapped.store(0);
+    c.lapEvents.store(0);
+    c.expired.store(0);
+    {
+        std::lock_guard<std::mutex> sigLock(g_sigMutex);
+        c.cursor.store(g_bcastNext.load());
+        c.active.store(1);
+        g_bcastConsumerCount.fetch_add(1);
+    }
+    return freeSlot + 1;
+}
+
+int AeronBridge_UnregisterConsumer(int consumerId)
+{
+    if (consumerId < 1 || consumerId > MAX_BCAST_CONSUMERS) return 0;
+
+    std::lock_guard<std::mutex> lock(g_consumerMutex);
+    BroadcastConsumer& c = g_consumers[consumerId - 1];
+    if (!c.active.load()) return 0;
+    c.active.store(0);
+    g_bcastConsumerCount.fetch_sub(1);
+    return 1;
+}
+
+int AeronBridge_GetConsumerSignalCsv(int consumerId, unsigned char* outBuf, int outBufLen)
+{
+    if (!outBuf || outBufLen <= 1) return 0;
+    if (consumerId < 1 || consumerId > MAX_BCAST_CONSUMERS) return 0;
+
+    BroadcastConsumer& c = g_consumers[consumerId - 1];
+    if (!c.active.load(std::memory_order_relaxed)) return 0;
+
+    flushDueNetting();
+    int64_t signalId = 0;
+    int32_t merged = 1;
+    const int n = readBroadcast(c, (char*)outBuf, outBufLen - 1, &signalId, &merged);
+    outBuf[n] = 0;
+    if (n > 0)
+    {
+        t_lastSignalId = signalId;
+        t_lastSignalMerged = merged;
+        counterAdd(CNT_SIGNALS_DELIVERED, 1);
+    }
+    return n;
+}
+
+int AeronBridge_GetConsumerStats(unsigned char* outBuf, int outBufLen)
+{
+    if (!outBuf || outBufLen <= 1) return 0;
+    outBuf[0] = 0;
+
+    // CSV per line: id,name,lap_policy,backlog,delivered,lapped,lap_events,expired
+    const int64_t head = g_bcastNext.load();
+    std::lock_guard<std::mutex> lock(g_consumerMutex);
+    int written = 0;
+    char line[160];
+    for (int i = 0; i < MAX_BCAST_CONSUMERS; i++)
+    {
+        const BroadcastConsumer& c = g_consumers[i];
+        if (!c.active.load()) continue;
+        const int64_t backlog = head - c.cursor.load();
+        const int n = std::snprintf(line, sizeof(line), "%d,%s,%d,%lld,%lld,%lld,%lld,%lld\n",
+            i + 1, c.name, c.lapPolicy, (long long)(backlog > 0 ? backlog : 0),
+            (long long)c.delivered.load(), (long long)c.lapped.load(), (long long)c.lapEvents.load(),
+            (long long)c.expired.load());
+        if (n <= 0 || written + n >= outBufLen) break;
+        std::memcpy(outBuf + written, line, (size_t)n);
+        written += n;
+        outBuf[written] = 0;
+    }
+    return written;
+}
+
+int AeronBridge_GetSignalBatchCsv(unsigned char* outBuf, int outBufLen, int maxSignals)
+{
+    if (!outBuf || outBufLen <= 1) return 0;
+    if (maxSignals <= 0) maxSignals = INT32_MAX;
+
+    const bool tracing = g_traceEnabled.load(std::memory_order_relaxed) != 0;
+    int written = 0;
+    int delivered = 0;
+    char idField[24];
+
+    std::lock_guard<std::mutex> lock(g_sigMutex);
+    while (delivered < maxSignals)
+    {
+        int laneId = 0;
+        const QueuedSignal* sig = peekSignalLocked(&laneId);
+        if (!sig) break;
+
+        // <csv>,<signal_id>\n - stop when the next line does not fit
+        const int idLen = std::snprintf(idField, sizeof(idField), ",%lld\n", (long long)sig->signalId);
+        if (written + sig->csvLen + idLen >= outBufLen) break;
+
+        std::memcpy(outBuf + written, sig->csv, (size_t)sig->csvLen);
+        written += sig->csvLen;
+        std::memcpy(outBuf + written, idField, (size_t)idLen);
+        written += idLen;
+
+        t_lastSignalId = sig->signalId;
+        t_lastSignalMerged = sig->merged;
+        if (tracing) traceStage(sig->signalId, TRACE_STAGE_DEQUEUED);
+        popSignalLocked(laneId);
+        delivered++;
+    }
+
+    if (delivered > 0) counterAdd(CNT_SIGNALS_DELIVERED, delivered);
+    outBuf[written] = 0;
+    return written;
+}
+
+int AeronBridge_ConfigureLane(int lane, int capacity, int dropPolicy)
+{
+    if (lane < 0 || lane >= LANE_COUNT)
+    {
+        setError("ConfigureLane: lane must be 0 (force exit), 1 (risk) or 2 (entry)");
+        return 0;
+    }
+    if (capacity <= 0 || capacity > 100000)
+    {
+        setError("ConfigureLane: capacity must be 1..100000");
+        return 0;
+    }
+    if (dropPolicy != DROP_NEWEST && dropPolicy != DROP_OLDEST)
+    {
+        setError("ConfigureLane: dropPolicy must be 0 (drop newest) or 1 (drop oldest)");
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(g_sigMutex);
+    SignalLane& l = g_lanes[lane];
+    if (l.count > 0)
+    {
+        setError("ConfigureLane: lane has queued signals, configure before polling");
+        return 0;
+    }
+    resizeLane(l, (size_t)capacity, dropPolicy);
+    return 1;
+}
+
+int AeronBridge_SetSignalTtl(int lane, int ttlMs)
+{
+    if (lane < 0 || lane >= LANE_COUNT)
+    {
+        setError("SetSignalTtl: lane must be 0 (force exit), 1 (risk) or 2 (entry)");
+        return 0;
+    }
+    if (ttlMs < 0)
+    {
+        setError("SetSignalTtl: ttlMs must be >= 0");
+        return 0;
+    }
+
+    g_laneTtlNs[lane].store((int64_t)ttlMs * 1000000);
+    return 1;
+}
+
+int AeronBridge_SetNettingWindow(int windowMs)
+{
+    if (windowMs < 0)
+    {
+        setError("SetNettingWindow: windowMs must be >= 0");
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(g_sigMutex);
+    g_nettingWindowNs.store((int64_t)windowMs * 1000000);
+    if (windowMs == 0)
+        flushDueNettingLocked(0, true);
+    return 1;
+}
+
+int AeronBridge_SetClockSkew(int publisherClockOffsetMs, int maxFutureSkewMs)
+{
+    if (maxFutureSkewMs < 0)
+    {
+        setError("SetClockSkew: maxFutureSkewMs must be >= 0");
+        return 0;
+    }
+
+    g_publisherClockOffsetNs.store((int64_t)publisherClockOffsetMs * 1000000);
+    g_maxFutureSkewNs.store((int64_t)maxFutureSkewMs * 1000000);
+    return 1;
+}
+
+int AeronBridge_GetLaneStats(unsigned char* outBuf, int outBufLen)
+{
+    if (!outBuf || outBufLen <= 1) return 0;
+
+    std::lock_guard<std::mutex> lock(g_sigMutex);
+
+    // CSV per line: lane,name,capacity,drop_policy,depth,hwm,enqueued,delivered,dropped,inversions_avoided,ttl_ms,expired
+    int written = 0;
+    char line[256];
+    for (int i = 0; i < LANE_COUNT; i++)
+    {
+        const SignalLane& l = g_lanes[i];
+        const int n = std::snprintf(line, sizeof(line), "%d,%s,%d,%d,%d,%lld,%lld,%lld,%lld,%lld,%lld,%lld\n",
+            i, LANE_NAMES[i], (int)l.slots.size(), l.dropPolicy, (int)l.count,
+            (long long)l.hwm, (long long)l.enqueued, (long long)l.delivered,
+            (long long)l.dropped, (long long)l.inversionsAvoided,
+            (long long)(g_laneTtlNs[i].load() / 1000000), (long long)l.expired);
+        if (n <= 0 || written + n >= outBufLen) break;
+        std::memcpy(outBuf + written, line, (size_t)n);
+        written += n;
+    }
+
+    outBuf[written] = 0;
+    return written;
+}
+
+static void closeSignalSubscriptions()
+{
+    if (g_subscription)
+    {
+        aeron_subscription_close(g_subscription, nullptr, nullptr);
+        g_subscription = nullptr;
+    }
+    for (aeron_subscription_t* subscription : g_shardSubscriptions)
+        aeron_subscription_close(subscription, nullptr, nullptr);
+    g_shardSubscriptions.clear();
+    std::lock_guard<std::mutex> lock(g_subStreamsMutex);
+    g_subStreams.clear();
+}
+
+// Closes the subscription and drops everything queued for it
+static void closeSubscription()
+{
+    closeSignalSubscriptions();
+
+    g_started.store(0);
+
+    {
+        std::lock_guard<std::mutex> lock(g_imageMutex);
+        g_images.clear();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(g_livenessMutex);
+        g_livenessCount.store(0);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(g_sigMutex);
+        // Clear the lanes (slots stay allocated)
+        for (int i = 0; i < LANE_COUNT; i++)
+        {
+            g_lanes[i].head = 0;
+            g_lanes[i].count = 0;
+        }
+        for (auto& p : g_netPending) p.active = false;
+        g_netActive = 0;
+    }
+}
+
+void AeronBridge_Stop()
+{
+    if (g_persistEnabled.load() && g_subscription)
+    {
+        // Snapshot before closing; the next StartW (same or reloaded DLL) restores it
+        sampleImageLag();
+        std::lock_guard<std::mutex> lock(g_sigMutex);
+        if (g_persistSegment) snapshotSignalsLocked(g_persistSegment);
+    }
+
+    closeSubscription();
+
+    // Only close shared context if no publishers are still active
+    cleanupAeronContextIfIdle();
+}
+
+int AeronBridge_SetPersistence(int enabled)
+{
+    if (enabled)
+    {
+        if (!openPersistSegment()) return 0;
+        g_persistEnabled.store(1);
+        return 1;
+    }
+
+    g_persistEnabled.store(0);
+    if (g_persistSegment)
+    {
+        std::lock_guard<std::mutex> lock(g_sigMutex);
+        g_persistSegment->magic = 0;
+    }
+    return 1;
+}
+
+int AeronBridge_LastError(unsigned char* outBuf, int outBufLen)
+{
+    if (!outBuf || outBufLen <= 1) return 0;
+
+    // Newest coded event wins over an older text error
+    ErrorEvent ev;
+    if (loadLastEvent(&ev) && ev.code != ERR_TEXT)
+    {
+        int64_t textNs = 0;
+        {
+            std::lock_guard<std::mutex> lock(g_errMutex);
+            textNs = g_lastErrorNs;
+        }
+        if (ev.timestampNs >= textNs)
+        {
+            int n = formatErrorMessage(ev, (char*)outBuf, (size_t)outBufLen);
+            if (n < 0) n = 0;
+            return (n >= outBufLen) ? (outBufLen - 1) : n;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(g_errMutex);
+    const int n = (int)g_lastError.size();
+    const int copyN = (n >= outBufLen) ? (outBufLen - 1) : n;
+
+    std::memcpy(outBuf, g_lastError.data(), (size_t)copyN);
+    outBuf[copyN] = 0;
+    return copyN;
+}
+
+int AeronBridge_GetErrors(unsigned char* outBuf, int outBufLen, int maxEvents)
+{
+    if (!outBuf || outBufLen <= 1) return 0;
+    if (maxEvents <= 0) maxEvents = (int)ERROR_RING_SIZE;
+
+    std::lock_guard<std::mutex> lock(g_errReadMutex);
+
+    int written = 0;
+    int events = 0;
+    char line[512];
+    char msg[384];
+
+    // Report ring overflow first so the gap is visible in order
+    const int64_t lost = g_errRingDropped.exchange(0, std::memory_order_relaxed);
+    if (lost > 0)
+    {
+        ErrorEvent ov{};
+        ov.timestampNs = wallClockNanos();
+        ov.code = ERR_RING_OVERFLOW;
+        ov.detail = lost;
+        formatErrorMessage(ov, msg, sizeof(msg));
+        const int n = std::snprintf(line, sizeof(line), "%lld,%d,0,,%lld,0,%s\n",
+            (long long)ov.timestampNs, (int)ov.code, (long long)lost, msg);
+        if (n > 0 && written + n < outBufLen)
+        {
+            std::memcpy(outBuf + written, line, (size_t)n);
+            written += n;
+        }
+        else
+        {
+            g_errRingDropped.fetch_add(lost, std::memory_order_relaxed);
+        }
+    }
+
+    // CSV per line: timestamp_ns,code,stream_id,instrument,detail,suppressed,message
+    ErrorEvent ev;
+    while (events < maxEvents && peekErrorEvent(&ev))
+    {
+        formatErrorMessage(ev, msg, sizeof(msg));
+        int n = std::snprintf(line, sizeof(line), "%lld,%d,%d,%s,%lld,%u,%s\n",
+            (long long)ev.timestampNs, (int)ev.code, (int)ev.streamId, ev.instrument,
+            (long long)ev.detail, (unsigned)ev.suppressed, msg);
+        if (n < 0) n = 0;
+        if (n >= (int)sizeof(line)) n = (int)sizeof(line) - 1;
+        if (written + n >= outBufLen) break;  // leave it queued for the next call
+
+        std::memcpy(outBuf + written, line, (size_t)n);
+        written += n;
+        events++;
+        popErrorEvent();
+    }
+
+    outBuf[written] = 0;
+    return written;
+}
+
+int AeronBridge_SetErrorRateLimit(int maxPerCodePerSecond)
+{
+    if (maxPerCodePerSecond < 0)
+    {
+        setError("SetErrorRateLimit: limit must be >= 0");
+        return 0;
+    }
+    g_errRateLimit.store(maxPerCodePerSecond);
+    return 1;
+}
+
+long long AeronBridge_NowNanos()
+{
+    int64_t nowNs = wallClockNanos();
+    if (nowNs <= t_lastNowNs) nowNs = t_lastNowNs + 1;  // re-sync never steps back
+    t_lastNowNs = nowNs;
+    return (long long)nowNs;
+}
+
+long long AeronBridge_LastSignalId()
+{
+    return (long long)t_lastSignalId;
+}
+
+int AeronBridge_LastSignalMerged()
+{
+    return (int)t_lastSignalMerged;
+}
+
+int AeronBridge_SetTracing(int enabled, int capacity)
+{
+    std::lock_guard<std::mutex> lock(g_traceMutex);
+
+    if (!enabled)
+    {
+        g_traceEnabled.store(0);
+        return 1;
+    }
+
+    if (capacity <= 0) capacity = 4096;
+    if (capacity > 1000000)
+    {
+        setError("SetTracing: capacity must be <= 1000000");
+        return 0;
+    }
+
+    TraceBuffer* current = g_traceBuffer.load();
+    if (!current || current->capacity != capacity)
+    {
+        g_traceEnabled.store(0);
+        std::unique_ptr<TraceBuffer> buffer(new TraceBuffer{ capacity, std::unique_ptr<TraceRecord[]>(new TraceRecord[(size_t)capacity]) });
+        TraceRecord* records = buffer->records.get();
+        for (int i = 0; i < capacity; i++)
+        {
+            records[i].signalId.store(0, std::memory_order_relaxed);
+            records[i].publishNs.store(0, std::memory_order_relaxed);
+            for (int s = 0; s < TRACE_STAGE_COUNT; s++)
+                records[i].stageNs[s].store(0, std::memory_order_relaxed);
+            records[i].action = 0;
+            records[i].instrument[0] = 0;
+        }
+        g_traceBuffer.store(buffer.get(), std::memory_order_release);
+        g_traceBuffers.push_back(std::move(buffer));
+    }
+
+    g_traceEnabled.store(1);
+    return 1;
+}
+
+int AeronBridge_MarkSignal(long long signalId, int stage)
+{
+    if (stage < TRACE_STAGE_EA_FIRST || stage >= TRACE_STAGE_COUNT) return 0;
+    if (!g_traceEnabled.load(std::memory_order_relaxed)) return 0;
+
+    TraceRecord* rec = traceSlot((int64_t)signalId);
+    if (!rec || rec->signalId.load(std::memory_order_acquire) != (int64_t)signalId) return 0;
+    rec->stageNs[stage].store(wallClockNanos(), std::memory_order_relaxed);
+    return 1;
+}
+
+int AeronBridge_DumpTraceW(const wchar_t* pathW)
+{
+    std::lock_guard<std::mutex> lock(g_traceMutex);
+
+    const TraceBuffer* buffer = g_traceBuffer.load(std::memory_order_acquire);
+    if (!buffer)
+    {
+        setError("DumpTrace: tracing was never enabled");
+        return 0;
+    }
+    const TraceRecord* records = buffer->records.get();
+    const int64_t capacity = buffer->capacity;
+
+    FILE* f = nullptr;
+    if (!pathW || _wfopen_s(&f, pathW, L"wb") != 0 || !f)
+    {
+        setError("DumpTrace: cannot open output file");
+        return 0;
+    }
+
+    // Chrome trace-event timestamps are microseconds; keep them relative to the
+    // earliest stamp so doubles keep sub-microsecond precision.
+    int64_t baseNs = INT64_MAX;
+    for (int64_t i = 0; i < capacity; i++)
+    {
+        if (records[i].signalId.load(std::memory_order_acquire) <= 0) continue;
+        const int64_t pub = records[i].publishNs.load(std::memory_order_relaxed);
+        const int64_t rcv = records[i].stageNs[TRACE_STAGE_RECEIVE].load(std::memory_order_relaxed);
+        const int64_t first = (pub > 0 && pub < rcv) ? pub : rcv;
+        if (first > 0 && first < baseNs) baseNs = first;
+    }
+    if (baseNs == INT64_MAX) baseNs = 0;
+
+    std::fprintf(f, "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"baseUtcNs\":%lld},\"traceEvents\":[\n", (long long)baseNs);
+
+    int signals = 0;
+    bool firstEvent = true;
+    for (int64_t i = 0; i < capacity; i++)
+    {
+        const TraceRecord& rec = records[i];
+        const int64_t id = rec.signalId.load(std::memory_order_acquire);
+        if (id <= 0) continue;
+
+        int64_t stamps[TRACE_STAGE_COUNT];
+        for (int s = 0; s < TRACE_STAGE_COUNT; s++)
+            stamps[s] = rec.stageNs[s].load(std::memory_order_relaxed);
+
+        // One async slice per interval between consecutive recorded stages;
+        // "transport" covers publisher timestamp -> receive.
+        int64_t prevNs = rec.publishNs.load(std::memory_order_relaxed);
+        const char* prevName = "transport";
+        for (int s = 0; s < TRACE_STAGE_COUNT; s++)
+        {
+            if (stamps[s] <= 0) continue;
+            if (prevNs > 0 && stamps[s] >= prevNs)
+            {
+                const char* name = prevName;
+                char eaName[16];
+                if (s >= TRACE_STAGE_EA_FIRST)
+                {
+                    std::snprintf(eaName, sizeof(eaName), "ea_stage_%d", s);
+                    name = eaName;
+                }
+                const double beginUs = (double)(prevNs - baseNs) / 1000.0;
+                const double endUs = (double)(stamps[s] - baseNs) / 1000.0;
+                std::fprintf(f,
+                    "%s{\"name\":\"%s\",\"cat\":\"signal\",\"ph\":\"b\",\"id\":%lld,\"pid\":1,\"tid\":1,\"ts\":%.3f,"
+                    "\"args\":{\"action\":%u,\"instrument\":\"%s\"}},\n"
+                    "{\"name\":\"%s\",\"cat\":\"signal\",\"ph\":\"e\",\"id\":%lld,\"pid\":1,\"tid\":1,\"ts\":%.3f}",
+                    firstEvent ? "" : ",\n",
+                    name, (long long)id, beginUs, (unsigned)rec.action, rec.instrument,
+                    name, (long long)id, endUs);
+                firstEvent = false;
+            }
+            prevNs = stamps[s];
+            prevName = traceStageName(s);
+        }
+        signals++;
+    }
+
+    std::fprintf(f, "\n]}\n");
+    std::fclose(f);
+    return signals;
+}
+
+long long AeronBridge_GetCounter(int counterId)
+{
+    if (counterId < 0 || counterId >= CNT_COUNT) return -1;
+    return (long long)InterlockedExchangeAdd64(counterAddr(counterId), 0);
+}
+
+int AeronBridge_SetUnmappedBehaviorW(
+    int allowUnmapped,
+    double defaultTickSize,
+    double defaultPointSize)
+{
+    if (defaultTickSize <= 0.0 || defaultPointSize <= 0.0)
+    {
+        setError("SetUnmappedBehavior: tick/point sizes must be > 0");
+        return 0;
+    }
+
+    g_allowUnmapped.store(allowUnmapped ? 1 : 0);
+    g_defaultTickSize = defaultTickSize;
+    g_defaultPointSize = defaultPointSize;
+
+    return 1;
+}
+
+// ===============================
+// Publisher API Implementation
+// ===============================
+
+int AeronBridge_StartPublisherW(
+    const wchar_t* aeronDirW,
+    const wchar_t* channelW,
+    int streamId,
+    int timeoutMs)
+{
+    if (g_pubStarted.load()) return 1;
+
+    const std::string aeronDir = wide_to_utf8(aeronDirW);
+    const std::string channel = wide_to_utf8(channelW);
+
+    if (!channelLooksValid(channel))
+    {
+        setError("Invalid Aeron publisher channel: must start with 'aeron:'");
+        return 0;
+    }
+    if (streamId <= 0)
+    {
+        setError("Invalid publisher streamId: must be > 0");
+        return 0;
+    }
+    if (timeoutMs <= 0) timeoutMs = 3000;
+
+    // Initialize Aeron context if not already done (might be shared with subscriber)
+    if (!g_aeron)
+    {
+        if (aeron_context_init(&g_context) < 0)
+        {
+            setErrorFromAeron("aeron_context_init failed (publisher)");
+            return 0;
+        }
+
+        if (!aeronDir.empty())
+        {
+            aeron_context_set_dir(g_context, aeronDir.c_str());
+        }
+        if (g_warmupFrames.load() > 0)
+            aeron_context_set_pre_touch_mapped_memory(g_context, true);
+
+        if (aeron_init(&g_aeron, g_context) < 0)
+        {
+            setErrorFromAeron("aeron_init failed (publisher)");
+            return 0;
+        }
+
+        if (aeron_start(g_aeron) < 0)
+        {
+            setErrorFromAeron("aeron_start failed (publisher)");
+            return 0;
+        }
+
+        registerBridgeCounters();
+    }
+
+    // Add publication async
+    if (aeron_async_add_publication(
+        &g_asyncPub,
+        g_aeron,
+        channel.c_str(),
+        streamId) < 0)
+    {
+        setErrorFromAeron("aeron_async_add_publication failed");
+        return 0;
+    }
+
+    // Wait for publication to be ready
+    const auto deadline = std::chrono::steady_clock::now() + 
+                         std::chrono::milliseconds(timeoutMs);
+    
+    int pollRes = 0;
+    while (true)
+    {
+        pollRes = aeron_async_add_publication_poll(&g_publication, g_asyncPub);
+        if (pollRes < 0)
+        {
+            setErrorFromAeron("aeron_async_add_publication_poll failed");
+            g_asyncPub = nullptr;
+            return 0;
+        }
+        if (pollRes > 0)
+        {
+            break;  // Ready
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            setError("Publication timeout: MediaDriver down or channel issue");
+            g_asyncPub = nullptr;
+            return 0;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    g_pubStreamId = streamId;
+    g_pubCounters = registerEndpointCounters("Publication", streamId);
+    g_pubStarted.store(1);
+    return 1;
+}
+
+int AeronBridge_PublishBinary(const unsigned char* buffer, int bufferLen)
+{
+    if (!g_publication)
+    {
+        setError("Publication not initialized");
+        return 0;
+    }
+
+    if (!buffer || bufferLen != FRAME_SIZE)
+    {
+        setError("PublishBinary: buffer must be exactly 104 bytes");
+        return 0;
+    }
+
+    uint8_t stamped[FRAME_SIZE];
+    const uint8_t* frame = stampFrameIfUnset((const uint8_t*)buffer, stamped);
+    rememberSent(frame);
+    rememberPublishedState(frame);
+
+    // Attempt to offer the message
+    return offerToPublication(
+        g_publication,
+        frame,
+        (size_t)bufferLen,
+        ORIGIN_PUBLISHER,
+        g_pubStreamId,
+        &g_pubCounters);
+}
+
+void AeronBridge_StopPublisher()
+{
+    {
+        // Heartbeat thread and health queries read g_publication under g_pubMux
+        std::lock_guard<std::mutex> lock(g_pubMux);
+        if (g_publication)
+        {
+            aeron_publication_close(g_publication, nullptr, nullptr);
+            g_publication = nullptr;
+            closeEndpointCounters(g_pubCounters);
+        }
+    }
+    g_asyncPub = nullptr;
+    g_pubStarted.store(0);
+
+    cleanupAeronContextIfIdle();
+}
+
+// ===============================
+// Dual Publisher API (IPC + UDP)
+// ===============================
+
+// Initialize the shared Aeron client if not already done (might be shared with subscriber).
+// who is used in error messages, e.g. "aeron_init failed (IPC publisher)".
+static int ensureAeronClient(const std::string& aeronDir, const std::string& who)
+{
+    if (g_aeron) return 1;
+
+    if (aeron_context_init(&g_context) < 0)
+    {
+        setErrorFromAeron(("aeron_context_init failed (" + who + ")").c_str());
+        return 0;
     }
 
-    const int slPoints = ticksToMt5Points(slTicks, map);
-    const int ptPoints = ticksToMt5Points(pt, map);
+    if (!aeronDir.empty())
+    {
+        aeron_context_set_dir(g_context, aeronDir.c_str());
+    }
+    if (g_warmupFrames.load() > 0)
+        aeron_context_set_pre_touch_mapped_memory(g_context, true);
 
-    // Build CSV
-    // action,qty,sl_points,pt_points,confidence,symbol,mt5_symbol,source,instrument
-    char csv[512];
-    std::snprintf(
-        csv, sizeof(csv),
-        "%u,%d,%d,%d,%.2f,%s,%s,%s,%s",
-        (unsigned)action,
-        (int)qty,
-        (int)slPoints,
-        (int)ptPoints,
-        (double)confidence,
-        sym.c_str(),
-        map.mt5Symbol.c_str(),
-        src.c_str(),
-        inst.c_str());
+    if (aeron_init(&g_aeron, g_context) < 0)
+    {
+        setErrorFromAeron(("aeron_init failed (" + who + ")").c_str());
+        return 0;
+    }
 
+    if (aeron_start(g_aeron) < 0)
     {
-        std::lock_guard<std::mutex> lock(g_sigMutex);
-        // Queue the signal instead of overwriting
-        if (g_signalQueue.size() < MAX_QUEUE_SIZE)
-        {
-            g_signalQueue.push(std::string(csv));
-        }
-        // else: drop oldest or newest - here we drop newest if full
+        setErrorFromAeron(("aeron_start failed (" + who + ")").c_str());
+        return 0;
     }
+
+    registerBridgeCounters();
+    return 1;
 }
 
-// ===============================
-// Exported API
-// ===============================
-int AeronBridge_StartW(const wchar_t* aeronDirW, const wchar_t* channelW, int streamId, int timeoutMs)
+// Shared start path for multi-endpoint publishers (IPC, UDP, ack back-channel).
+// kind is used in error messages, e.g. "IPC" -> "aeron_init failed (IPC publisher)".
+static int startPublisherEndpoint(
+    const std::string& aeronDir,
+    const std::string& channel,
+    int streamId,
+    int timeoutMs,
+    const char* kind,
+    std::vector<PublisherEndpoint>& publications)
 {
-    if (g_started.load()) return 1;
-
-    const std::string aeronDir = wide_to_utf8(aeronDirW);
-    const std::string channel = wide_to_utf8(channelW);
+    const std::string k(kind);
 
     if (!channelLooksValid(channel))
     {
-        setError("Invalid Aeron channel: must start with 'aeron:'");
+        setError("Invalid Aeron " + k + " publisher channel: must start with 'aeron:'");
         return 0;
     }
     if (streamId <= 0)
     {
-        setError("Invalid streamId: must be > 0");
+        setError("Invalid " + k + " publisher streamId: must be > 0");
         return 0;
     }
     if (timeoutMs <= 0) timeoutMs = 3000;
 
-    ensureDefaultMap();
+    {
+        std::lock_guard<std::mutex> lock(g_pubMux);
+        if (isPublicationRegistered(publications, channel, streamId))
+            return 1;
+    }
 
-    if (aeron_context_init(&g_context) < 0)
+    if (!ensureAeronClient(aeronDir, k + " publisher"))
+        return 0;
+
+    aeron_async_add_publication_t* asyncPub = nullptr;
+    aeron_publication_t* publication = nullptr;
+
+    // Add publication async
+    if (aeron_async_add_publication(
+        &asyncPub,
+        g_aeron,
+        channel.c_str(),
+        streamId) < 0)
     {
-        setErrorFromAeron("aeron_context_init failed");
+        setErrorFromAeron(("aeron_async_add_publication failed (" + k + ")").c_str());
         return 0;
     }
 
-    if (!aeronDir.empty())
+    // Wait for publication to be ready
+    const auto deadline = std::chrono::steady_clock::now() + 
+                         std::chrono::milliseconds(timeoutMs);
+    
+    int pollRes = 0;
+    while (true)
     {
-        aeron_context_set_dir(g_context, aeronDir.c_str());
+        pollRes = aeron_async_add_publication_poll(&publication, asyncPub);
+        if (pollRes < 0)
+        {
+            setErrorFromAeron(("aeron_async_add_publication_poll failed (" + k + ")").c_str());
+            return 0;
+        }
+        if (pollRes > 0)
+        {
+            break;  // Ready
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            setError(k + " Publication timeout: MediaDriver down or channel issue");
+            return 0;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
 
-    if (aeron_init(&g_aeron, g_context) < 0)
     {
-        setErrorFromAeron("aeron_init failed");
+        std::lock_guard<std::mutex> lock(g_pubMux);
+        if (!isPublicationRegistered(publications, channel, streamId))
+        {
+            publications.push_back(PublisherEndpoint{ channel, streamId, publication, registerEndpointCounters(kind, streamId) });
+            if (channel.find("control-mode=manual") != std::string::npos)
+                g_mdcDestinations[publication];
+        }
+    }
+
+    return 1;
+}
+
+// streamId plus, while sharding is on, one endpoint per shard stream on the same channel
+static int startShardedEndpoints(
+    const std::string& aeronDir,
+    const std::string& channel,
+    int streamId,
+    int timeoutMs,
+    const char* kind,
+    std::vector<PublisherEndpoint>& publications)
+{
+    if (!startPublisherEndpoint(aeronDir, channel, streamId, timeoutMs, kind, publications))
         return 0;
+    for (int shard : shardStreams())
+    {
+        if (!startPublisherEndpoint(aeronDir, channel, shard, timeoutMs, kind, publications))
+            return 0;
     }
+    return 1;
+}
 
-    if (aeron_start(g_aeron) < 0)
+int AeronBridge_StartPublisherIpcW(
+    const wchar_t* aeronDirW,
+    const wchar_t* channelW,
+    int streamId,
+    int timeoutMs)
+{
+    if (!startShardedEndpoints(wide_to_utf8(aeronDirW), wide_to_utf8(channelW), streamId, timeoutMs, "IPC", g_ipcPublications))
+        return 0;
+
+    g_pubIpcStarted.store(1);
+    return 1;
+}
+
+int AeronBridge_StartPublisherUdpW(
+    const wchar_t* aeronDirW,
+    const wchar_t* channelW,
+    int streamId,
+    int timeoutMs)
+{
+    if (!startShardedEndpoints(wide_to_utf8(aeronDirW), wide_to_utf8(channelW), streamId, timeoutMs, "UDP", g_udpPublications))
+        return 0;
+
+    g_pubUdpStarted.store(1);
+    return 1;
+}
+
+int AeronBridge_StartPublisherMdcW(
+    const wchar_t* aeronDirW,
+    const wchar_t* controlEndpointW,
+    int streamId,
+    int timeoutMs)
+{
+    // Empty control endpoint = manual mode (destinations added by the EA),
+    // otherwise dynamic mode (subscribers join via the control endpoint)
+    const std::string controlEndpoint = wide_to_utf8(controlEndpointW);
+    const std::string channel = controlEndpoint.empty()
+        ? std::string("aeron:udp?control-mode=manual")
+        : "aeron:udp?control=" + controlEndpoint + "|control-mode=dynamic";
+
+    if (!startPublisherEndpoint(wide_to_utf8(aeronDirW), channel, streamId, timeoutMs, "MDC", g_udpPublications))
+        return 0;
+
+    g_pubUdpStarted.store(1);
+    return 1;
+}
+
+int AeronBridge_StartPublisherTunedW(
+    const wchar_t* aeronDirW,
+    const wchar_t* channelW,
+    int streamId,
+    int timeoutMs,
+    int termLength,
+    int mtu,
+    int sparse,
+    int lingerMs,
+    int sessionId)
+{
+    const std::string base = wide_to_utf8(channelW);
+    const bool ipc = base.rfind("aeron:ipc", 0) == 0;
+    if (!ipc && base.rfind("aeron:udp", 0) != 0)
     {
-        setErrorFromAeron("aeron_start failed");
+        setError("StartPublisherTuned: channel must start with 'aeron:ipc' or 'aeron:udp'");
         return 0;
     }
 
-    // Subscribe async + timeout
-    if (aeron_async_add_subscription(
-        &g_asyncSub,
-        g_aeron,
-        channel.c_str(),
-        streamId,
-        nullptr, nullptr, nullptr, nullptr) < 0)
+    std::string err;
+    const std::string channel = tunedChannel(base, ChannelTuning{ termLength, mtu, sparse, lingerMs, sessionId }, &err);
+    if (channel.empty())
     {
-        setErrorFromAeron("aeron_async_add_subscription failed");
+        setError("StartPublisherTuned: " + err);
         return 0;
     }
 
-    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    if (!startPublisherEndpoint(wide_to_utf8(aeronDirW), channel, streamId, timeoutMs,
+        ipc ? "IPC" : "UDP", ipc ? g_ipcPublications : g_udpPublications))
+        return 0;
 
-    int pollRes = 0;
+    (ipc ? g_pubIpcStarted : g_pubUdpStarted).store(1);
+    return 1;
+}
+
+// Shared path for add/remove destination on a manual MDC publication.
+static int changeMdcDestination(int streamId, const wchar_t* endpointW, bool add)
+{
+    const char* what = add ? "AddPublisherDestination" : "RemovePublisherDestination";
+    const std::string endpoint = wide_to_utf8(endpointW);
+    if (endpoint.empty() || endpoint.find(':') == std::string::npos)
+    {
+        setError(std::string(what) + ": endpoint must be host:port");
+        return 0;
+    }
+    const std::string uri = "aeron:udp?endpoint=" + endpoint;
+
+    aeron_publication_t* publication = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(g_pubMux);
+        for (const auto& ep : g_udpPublications)
+        {
+            if (ep.streamId == streamId && ep.channel.find("control-mode=manual") != std::string::npos)
+            {
+                publication = ep.publication;
+                break;
+            }
+        }
+        if (publication)
+        {
+            const auto& dests = g_mdcDestinations[publication];
+            const bool present = std::find(dests.begin(), dests.end(), endpoint) != dests.end();
+            if (present == add) return 1;  // already in the requested state
+        }
+    }
+    if (!publication)
+    {
+        setError(std::string(what) + ": no manual MDC publication on stream " + std::to_string(streamId));
+        return 0;
+    }
+
+    aeron_async_destination_t* async = nullptr;
+    const int rc = add
+        ? aeron_publication_async_add_destination(&async, g_aeron, publication, uri.c_str())
+        : aeron_publication_async_remove_destination(&async, g_aeron, publication, uri.c_str());
+    if (rc < 0)
+    {
+        setErrorFromAeron(what);
+        return 0;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(3000);
     while (true)
     {
-        pollRes = aeron_async_add_subscription_poll(&g_subscription, g_asyncSub);
+        const int pollRes = aeron_publication_async_destination_poll(async);
         if (pollRes < 0)
         {
-            setErrorFromAeron("aeron_async_add_subscription_poll failed");
-            g_asyncSub = nullptr;
+            setErrorFromAeron(what);
             return 0;
         }
-        if (pollRes > 0)
+        if (pollRes > 0) break;
+        if (std::chrono::steady_clock::now() >= deadline)
         {
-            // Ready
-            break;
+            setError(std::string(what) + ": timeout waiting for MediaDriver");
+            return 0;
         }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
 
-        if (std::chrono::steady_clock::now() >= deadline)
+    std::lock_guard<std::mutex> lock(g_pubMux);
+    auto it = g_mdcDestinations.find(publication);
+    if (it == g_mdcDestinations.end()) return 1;  // publisher stopped meanwhile
+    auto& dests = it->second;
+    if (add)
+        dests.push_back(endpoint);
+    else
+        dests.erase(std::remove(dests.begin(), dests.end(), endpoint), dests.end());
+    return 1;
+}
+
+int AeronBridge_AddPublisherDestinationW(int streamId, const wchar_t* endpointW)
+{
+    return changeMdcDestination(streamId, endpointW, true);
+}
+
+int AeronBridge_RemovePublisherDestinationW(int streamId, const wchar_t* endpointW)
+{
+    return changeMdcDestination(streamId, endpointW, false);
+}
+
+int AeronBridge_GetPublisherDestinations(int streamId, unsigned char* outBuf, int outBufLen)
+{
+    if (!outBuf || outBufLen <= 1) return 0;
+    outBuf[0] = 0;
+
+    // One host:port per line
+    std::lock_guard<std::mutex> lock(g_pubMux);
+    int written = 0;
+    for (const auto& ep : g_udpPublications)
+    {
+        if (ep.streamId != streamId) continue;
+        auto it = g_mdcDestinations.find(ep.publication);
+        if (it == g_mdcDestinations.end()) continue;
+        for (const auto& dest : it->second)
         {
-            setError("Subscribe timeout: MediaDriver down or channel/stream mismatch");
-            g_asyncSub = nullptr;
-            return 0;
+            const int n = (int)dest.size() + 1;
+            if (written + n >= outBufLen) return written;
+            std::memcpy(outBuf + written, dest.c_str(), dest.size());
+            outBuf[written + n - 1] = '\n';
+            written += n;
+            outBuf[written] = 0;
         }
+    }
+    return written;
+}
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+int AeronBridge_PublishBinaryIpc(const unsigned char* buffer, int bufferLen)
+{
+    if (!buffer || bufferLen != FRAME_SIZE)
+    {
+        setError("PublishBinaryIpc: buffer must be exactly 104 bytes");
+        return 0;
+    }
+
+    // Offer under g_pubMux (offers never block): no per-call endpoint copy, and
+    // a concurrent stop cannot close a publication mid-offer
+    std::lock_guard<std::mutex> lock(g_pubMux);
+    if (g_ipcPublications.empty())
+    {
+        setError("IPC Publication not initialized");
+        return 0;
+    }
+
+    uint8_t stamped[FRAME_SIZE];
+    const uint8_t* frame = stampFrameIfUnset((const uint8_t*)buffer, stamped);
+    rememberSent(frame);
+    rememberPublishedState(frame);
+
+    int offered = 0;
+    for (const auto& endpoint : g_ipcPublications)
+    {
+        if (!shardCarries(endpoint.streamId, frame + INSTRUMENT_OFFSET)) continue;
+        if (!offerToPublication(endpoint.publication, frame, (size_t)bufferLen, ORIGIN_PUBLISHER_IPC, endpoint.streamId, &endpoint.counters))
+            return 0;
+        offered++;
+    }
+    if (offered == 0)
+    {
+        setError("PublishBinaryIpc: no IPC endpoint on the instrument's shard stream");
+        return 0;
     }
 
-    g_started.store(1);
     return 1;
 }
 
-int AeronBridge_RegisterInstrumentMapW(
-    const wchar_t* futPrefixW,
-    const wchar_t* mt5SymbolW,
-    double futTickSize,
-    double mt5PointSize)
+int AeronBridge_PublishBinaryUdp(const unsigned char* buffer, int bufferLen)
 {
-    const std::string futPrefix = wide_to_utf8(futPrefixW);
-    const std::string mt5Symbol = wide_to_utf8(mt5SymbolW);
+    if (!buffer || bufferLen != FRAME_SIZE)
+    {
+        setError("PublishBinaryUdp: buffer must be exactly 104 bytes");
+        return 0;
+    }
 
-    if (futPrefix.empty() || mt5Symbol.empty())
+    // Offer under g_pubMux (offers never block): no per-call endpoint copy, and
+    // a concurrent stop cannot close a publication mid-offer
+    std::lock_guard<std::mutex> lock(g_pubMux);
+    if (g_udpPublications.empty())
     {
-        setError("RegisterInstrumentMap: futPrefix/mt5Symbol cannot be empty");
+        setError("UDP Publication not initialized");
         return 0;
     }
-    if (futTickSize <= 0.0 || mt5PointSize <= 0.0)
+
+    uint8_t stamped[FRAME_SIZE];
+    const uint8_t* frame = stampFrameIfUnset((const uint8_t*)buffer, stamped);
+    rememberSent(frame);
+    rememberPublishedState(frame);
+
+    int offered = 0;
+    for (const auto& endpoint : g_udpPublications)
+    {
+        if (!shardCarries(endpoint.streamId, frame + INSTRUMENT_OFFSET)) continue;
+        if (!offerToPublication(endpoint.publication, frame, (size_t)bufferLen, ORIGIN_PUBLISHER_UDP, endpoint.streamId, &endpoint.counters))
+            return 0;
+        offered++;
+    }
+    if (offered == 0)
+    {
+        setError("PublishBinaryUdp: no UDP endpoint on the instrument's shard stream");
+        return 0;
+    }
+
+    return 1;
+}
+
+// Helper: clean up shared Aeron context when nothing is using it
+static void cleanupAeronContextIfIdle()
+{
+    bool hasIpcPublications = false;
+    bool hasUdpPublications = false;
+    bool hasAckPublications = false;
+    bool hasQuotePublications = false;
+    bool hasSignalPublications = false;
+    {
+        std::lock_guard<std::mutex> lock(g_pubMux);
+        hasIpcPublications = !g_ipcPublications.empty();
+        hasUdpPublications = !g_udpPublications.empty();
+        hasAckPublications = !g_ackPublications.empty();
+        hasQuotePublications = !g_quotePublications.empty();
+        hasSignalPublications = g_publication || hasIpcPublications || hasUdpPublications;
+    }
+
+    // DLL threads stop with the last publication they feed: a std::thread still
+    // joinable when the DLL unloads calls std::terminate and takes MT5 down.
+    if (!hasSignalPublications)
     {
-        setError("RegisterInstrumentMap: tick/point sizes must be > 0");
-        return 0;
+        AeronBridge_StopHeartbeat();
+        AeronBridge_StopStateSnapshots();
     }
+    if (!hasQuotePublications)
+        stopQuoteSender();
+
+    // Don't close if any publisher or subscriber is still active
+    if (hasIpcPublications || hasUdpPublications || hasAckPublications || hasQuotePublications ||
+        g_publication || g_subscription || g_ackSubscription)
+        return;
+
+    releaseBridgeCounters();
 
+    if (g_aeron)
     {
-        std::lock_guard<std::mutex> lock(g_mapMutex);
-        g_map[futPrefix] = InstMap{ mt5Symbol, futTickSize, mt5PointSize };
+        aeron_close(g_aeron);
+        g_aeron = nullptr;
     }
 
-    return 1;
+    if (g_context)
+    {
+        aeron_context_close(g_context);
+        g_context = nullptr;
+    }
 }
 
-int AeronBridge_Poll()
+// ===============================
+// Publisher flow-control health
+// ===============================
+// Appends one CSV line; returns false when outBuf is full.
+static bool appendPublisherHealth(
+    const char* kind,
+    aeron_publication_t* publication,
+    unsigned char* outBuf,
+    int outBufLen,
+    int* written)
 {
-    if (!g_subscription) return 0;
-
-    return (int)aeron_subscription_poll(
-        g_subscription,
-        onFragment,
-        nullptr,
-        10);
+    aeron_publication_constants_t constants;
+    if (aeron_publication_constants(publication, &constants) < 0) return true;
+
+    const int connected = aeron_publication_is_connected(publication) ? 1 : 0;
+    const int64_t position = aeron_publication_position(publication);
+    const int64_t limit = aeron_publication_position_limit(publication);
+    const int64_t window = limit > position ? limit - position : 0;
+    const int64_t status = aeron_publication_channel_status(publication);
+
+    char line[512];
+    const int n = std::snprintf(line, sizeof(line), "%s,%d,%d,%d,%lld,%lld,%lld,%lld,%lld,%s\n",
+        kind, (int)constants.stream_id, (int)constants.session_id, connected,
+        (long long)position, (long long)limit, (long long)window,
+        (long long)constants.term_buffer_length, (long long)status,
+        constants.channel ? constants.channel : "");
+    if (n <= 0 || *written + n >= outBufLen) return false;
+    std::memcpy(outBuf + *written, line, (size_t)n);
+    *written += n;
+    outBuf[*written] = 0;
+    return true;
 }
 
-int AeronBridge_HasSignal()
+int AeronBridge_GetPublisherHealth(unsigned char* outBuf, int outBufLen)
 {
-    std::lock_guard<std::mutex> lock(g_sigMutex);
-    return g_signalQueue.empty() ? 0 : 1;
+    if (!outBuf || outBufLen <= 1) return 0;
+    outBuf[0] = 0;
+
+    // CSV per line: kind,stream_id,session_id,connected,position,position_limit,window,term_length,channel_status,channel
+    int written = 0;
+    std::lock_guard<std::mutex> lock(g_pubMux);
+    if (g_publication && !appendPublisherHealth("legacy", g_publication, outBuf, outBufLen, &written))
+        return written;
+    for (const auto& ep : g_ipcPublications)
+        if (!appendPublisherHealth("ipc", ep.publication, outBuf, outBufLen, &written)) return written;
+    for (const auto& ep : g_udpPublications)
+        if (!appendPublisherHealth("udp", ep.publication, outBuf, outBufLen, &written)) return written;
+    for (const auto& ep : g_ackPublications)
+        if (!appendPublisherHealth("ack", ep.publication, outBuf, outBufLen, &written)) return written;
+    for (const auto& ep : g_quotePublications)
+        if (!appendPublisherHealth("quote", ep.publication, outBuf, outBufLen, &written)) return written;
+    return written;
 }
 
-int AeronBridge_GetSignalCsv(unsigned char* outBuf, int outBufLen)
+// Smallest window across publications matching streamId (0 = any), -1 if none
+// are connected. Scalar form of GetPublisherHealth for per-signal checks.
+static void minWindow(aeron_publication_t* publication, int streamId, int64_t* best)
 {
-    if (!outBuf || outBufLen <= 1) return 0;
+    if (!publication) return;
+    if (streamId != 0)
+    {
+        aeron_publication_constants_t constants;
+        if (aeron_publication_constants(publication, &constants) < 0 || constants.stream_id != streamId)
+            return;
+    }
+    if (!aeron_publication_is_connected(publication)) return;
 
-    std::lock_guard<std::mutex> lock(g_sigMutex);
-    if (g_signalQueue.empty()) return 0;
+    const int64_t position = aeron_publication_position(publication);
+    const int64_t limit = aeron_publication_position_limit(publication);
+    const int64_t window = limit > position ? limit - position : 0;
+    if (*best < 0 || window < *best) *best = window;
+}
 
-    const std::string& csv = g_signalQueue.front();
-    const int n = (int)csv.size();
-    const int copyN = (n >= outBufLen) ? (outBufLen - 1) : n;
+long long AeronBridge_GetPublisherWindow(int streamId)
+{
+    int64_t best = -1;
+    std::lock_guard<std::mutex> lock(g_pubMux);
+    minWindow(g_publication, streamId, &best);
+    for (const auto& ep : g_ipcPublications) minWindow(ep.publication, streamId, &best);
+    for (const auto& ep : g_udpPublications) minWindow(ep.publication, streamId, &best);
+    return (long long)best;
+}
 
-    std::memcpy(outBuf, csv.data(), (size_t)copyN);
-    outBuf[copyN] = 0;
+// One memory report line; *total accumulates mapped bytes even when the
+// line no longer fits
+static void appendMemoryLine(
+    const char* kind,
+    int streamId,
+    int sessionId,
+    int64_t termLength,
+    int mtu,
+    const char* channel,
+    unsigned char* outBuf,
+    int outBufLen,
+    int* written,
+    int64_t* total)
+{
+    const int64_t mapped = logBufferBytes(termLength);
+    *total += mapped;
+    if (!outBuf) return;
+
+    char line[512];
+    const int n = std::snprintf(line, sizeof(line), "%s,%d,%d,%lld,%d,%lld,%s\n",
+        kind, streamId, sessionId, (long long)termLength, mtu, (long long)mapped, channel);
+    if (n <= 0 || *written + n >= outBufLen) return;
+    std::memcpy(outBuf + *written, line, (size_t)n);
+    *written += n;
+    outBuf[*written] = 0;
+}
 
-    g_signalQueue.pop();  // Remove from queue after reading
-    return copyN;
+static void appendPublicationMemory(
+    const char* kind,
+    aeron_publication_t* publication,
+    unsigned char* outBuf,
+    int outBufLen,
+    int* written,
+    int64_t* total)
+{
+    aeron_publication_constants_t constants;
+    if (!publication || aeron_publication_constants(publication, &constants) < 0) return;
+    appendMemoryLine(kind, constants.stream_id, constants.session_id, (int64_t)constants.term_buffer_length,
+        (int)constants.max_payload_length + DATA_HEADER_LENGTH, constants.channel ? constants.channel : "",
+        outBuf, outBufLen, written, total);
 }
 
-void AeronBridge_Stop()
+// Shared by GetMemoryReport and GetMappedBytes (outBuf null = total only)
+static int64_t collectMemoryReport(unsigned char* outBuf, int outBufLen, int* written)
 {
-    if (g_subscription)
+    int64_t total = 0;
     {
-        aeron_subscription_close(g_subscription, nullptr, nullptr);
-        g_subscription = nullptr;
+        std::lock_guard<std::mutex> lock(g_pubMux);
+        appendPublicationMemory("legacy", g_publication, outBuf, outBufLen, written, &total);
+        for (const auto& ep : g_ipcPublications) appendPublicationMemory("ipc", ep.publication, outBuf, outBufLen, written, &total);
+        for (const auto& ep : g_udpPublications) appendPublicationMemory("udp", ep.publication, outBuf, outBufLen, written, &total);
+        for (const auto& ep : g_ackPublications) appendPublicationMemory("ack", ep.publication, outBuf, outBufLen, written, &total);
+        for (const auto& ep : g_quotePublications) appendPublicationMemory("quote", ep.publication, outBuf, outBufLen, written, &total);
+    }
+    {
+        const int streamId = g_subStreamId.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(g_imageMutex);
+        for (const auto& r : g_images)
+        {
+            if (r.leaveNs != 0) continue;  // unmapped once the image is gone
+            appendMemoryLine("image", streamId, r.sessionId, r.termLength, r.mtu, r.source,
+                outBuf, outBufLen, written, &total);
+        }
     }
+    return total;
+}
 
-    g_asyncSub = nullptr;
-    g_started.store(0);
+int AeronBridge_GetMemoryReport(unsigned char* outBuf, int outBufLen)
+{
+    if (!outBuf || outBufLen <= 1) return 0;
+    outBuf[0] = 0;
+
+    // CSV per line: kind,stream_id,session_id,term_length,mtu,mapped_bytes,channel
+    // followed by total,0,0,0,0,<sum of mapped_bytes>,
+    int written = 0;
+    const int64_t total = collectMemoryReport(outBuf, outBufLen, &written);
 
+    char line[64];
+    const int n = std::snprintf(line, sizeof(line), "total,0,0,0,0,%lld,\n", (long long)total);
+    if (n > 0 && written + n < outBufLen)
     {
-        std::lock_guard<std::mutex> lock(g_sigMutex);
-        // Clear the queue
-        while (!g_signalQueue.empty())
-            g_signalQueue.pop();
+        std::memcpy(outBuf + written, line, (size_t)n);
+        written += n;
+        outBuf[written] = 0;
     }
+    return written;
+}
 
-    // Only close shared context if no publishers are still active
-    cleanupAeronContextIfIdle();
+long long AeronBridge_GetMappedBytes()
+{
+    int written = 0;
+    return (long long)collectMemoryReport(nullptr, 0, &written);
 }
 
-int AeronBridge_LastError(unsigned char* outBuf, int outBufLen)
+// ===============================
+// Publisher heartbeats
+// ===============================
+// A DLL thread offers a heartbeat frame on every signal publication (legacy,
+// IPC, UDP/MDC) at a fixed interval, independent of the EA's timer. Offers go
+// straight to the publication: a missed heartbeat is what the subscriber is
+// looking for, so failures are not retried or reported.
+static std::mutex g_hbControlMutex;  // Start/StopHeartbeat
+static std::mutex g_hbMutex;         // g_hbStop / wakeups
+static std::condition_variable g_hbCv;
+static std::thread g_hbThread;
+static bool g_hbStop = false;
+
+static void offerHeartbeat(aeron_publication_t* publication, const uint8_t* frame)
 {
-    if (!outBuf || outBufLen <= 1) return 0;
+    if (publication && aeron_publication_offer(publication, frame, HEARTBEAT_FRAME_SIZE, nullptr, nullptr) > 0)
+        counterAdd(CNT_HEARTBEATS_SENT, 1);
+}
 
-    std::lock_guard<std::mutex> lock(g_errMutex);
-    const int n = (int)g_lastError.size();
-    const int copyN = (n >= outBufLen) ? (outBufLen - 1) : n;
+static void heartbeatLoop(std::string source, int intervalMs)
+{
+    uint8_t frame[HEARTBEAT_FRAME_SIZE];
+    int64_t sequence = 0;
+    auto next = std::chrono::steady_clock::now();
 
-    std::memcpy(outBuf, g_lastError.data(), (size_t)copyN);
-    outBuf[copyN] = 0;
-    return copyN;
+    std::unique_lock<std::mutex> lock(g_hbMutex);
+    while (!g_hbStop)
+    {
+        lock.unlock();
+        encodeHeartbeatFrame(frame, wallClockNanos(), ++sequence, intervalMs, source.c_str());
+        {
+            std::lock_guard<std::mutex> pubLock(g_pubMux);
+            offerHeartbeat(g_publication, frame);
+            for (const auto& ep : g_ipcPublications) offerHeartbeat(ep.publication, frame);
+            for (const auto& ep : g_udpPublications) offerHeartbeat(ep.publication, frame);
+        }
+        lock.lock();
+
+        next += std::chrono::milliseconds(intervalMs);
+        g_hbCv.wait_until(lock, next, [] { return g_hbStop; });
+    }
 }
 
-int AeronBridge_SetUnmappedBehaviorW(
-    int allowUnmapped,
-    double defaultTickSize,
-    double defaultPointSize)
+static void stopHeartbeatThread()
 {
-    if (defaultTickSize <= 0.0 || defaultPointSize <= 0.0)
+    if (!g_hbThread.joinable()) return;
     {
-        setError("SetUnmappedBehavior: tick/point sizes must be > 0");
-        return 0;
+        std::lock_guard<std::mutex> lock(g_hbMutex);
+        g_hbStop = true;
     }
+    g_hbCv.notify_all();
+    g_hbThread.join();
+}
 
-    g_allowUnmapped.store(allowUnmapped ? 1 : 0);
-    g_defaultTickSize = defaultTickSize;
-    g_defaultPointSize = defaultPointSize;
+int AeronBridge_StartHeartbeatW(const wchar_t* source, int intervalMs)
+{
+    if (intervalMs <= 0)
+    {
+        setError("StartHeartbeat: intervalMs must be > 0");
+        return 0;
+    }
 
+    std::lock_guard<std::mutex> lock(g_hbControlMutex);
+    stopHeartbeatThread();  // restart with the new settings
+    g_hbStop = false;
+    g_hbThread = std::thread(heartbeatLoop, wide_to_utf8(source), intervalMs);
     return 1;
 }
 
+void AeronBridge_StopHeartbeat()
+{
+    std::lock_guard<std::mutex> lock(g_hbControlMutex);
+    stopHeartbeatThread();
+}
+
 // ===============================
-// Publisher API Implementation
+// Publisher state snapshots
 // ===============================
+// A DLL thread re-sends the last frame published per (source, instrument) as a
+// state frame on every signal publication, so a terminal that starts
+// mid-session can seed its latest-state cache within one interval. Like
+// heartbeats they go in-band and are not retried: the next round repeats them.
+static std::mutex g_snapControlMutex;  // Start/StopStateSnapshots
+static std::mutex g_snapMutex;         // g_snapStop / wakeups
+static std::condition_variable g_snapCv;
+static std::thread g_snapThread;
+static bool g_snapStop = false;
+
+static void offerStateFrame(aeron_publication_t* publication, const uint8_t* frame)
+{
+    if (publication && aeron_publication_offer(publication, frame, STATE_FRAME_SIZE, nullptr, nullptr) > 0)
+        counterAdd(CNT_STATE_SNAPSHOTS_SENT, 1);
+}
 
-int AeronBridge_StartPublisherW(
-    const wchar_t* aeronDirW,
-    const wchar_t* channelW,
-    int streamId,
-    int timeoutMs)
+static void stateSnapshotLoop(int intervalMs)
 {
-    if (g_pubStarted.load()) return 1;
+    static uint8_t frames[MAX_STATE_ENTRIES][STATE_FRAME_SIZE];  // snapshot thread only
+    auto next = std::chrono::steady_clock::now();
 
-    const std::string aeronDir = wide_to_utf8(aeronDirW);
-    const std::string channel = wide_to_utf8(channelW);
+    std::unique_lock<std::mutex> lock(g_snapMutex);
+    while (!g_snapStop)
+    {
+        lock.unlock();
+        int n = 0;
+        {
+            const int64_t nowNs = wallClockNanos();
+            std::lock_guard<std::mutex> stateLock(g_pubStateMutex);
+            for (; n < g_pubStateCount; n++)
+                encodeStateFrame(frames[n], nowNs, g_pubStates[n]);
+        }
+        if (n > 0)
+        {
+            std::lock_guard<std::mutex> pubLock(g_pubMux);
+            for (int i = 0; i < n; i++)
+            {
+                const uint8_t* instrument = frames[i] + STATE_SIGNAL_OFFSET + INSTRUMENT_OFFSET;
+                offerStateFrame(g_publication, frames[i]);
+                for (const auto& ep : g_ipcPublications)
+                    if (shardCarries(ep.streamId, instrument)) offerStateFrame(ep.publication, frames[i]);
+                for (const auto& ep : g_udpPublications)
+                    if (shardCarries(ep.streamId, instrument)) offerStateFrame(ep.publication, frames[i]);
+            }
+        }
+        lock.lock();
 
-    if (!channelLooksValid(channel))
+        next += std::chrono::milliseconds(intervalMs);
+        g_snapCv.wait_until(lock, next, [] { return g_snapStop; });
+    }
+}
+
+static void stopStateSnapshotThread()
+{
+    if (!g_snapThread.joinable()) return;
     {
-        setError("Invalid Aeron publisher channel: must start with 'aeron:'");
-        return 0;
+        std::lock_guard<std::mutex> lock(g_snapMutex);
+        g_snapStop = true;
     }
-    if (streamId <= 0)
+    g_snapCv.notify_all();
+    g_snapThread.join();
+}
+
+int AeronBridge_StartStateSnapshots(int intervalMs)
+{
+    if (intervalMs <= 0)
     {
-        setError("Invalid publisher streamId: must be > 0");
+        setError("StartStateSnapshots: intervalMs must be > 0");
         return 0;
     }
-    if (timeoutMs <= 0) timeoutMs = 3000;
 
-    // Initialize Aeron context if not already done (might be shared with subscriber)
-    if (!g_aeron)
-    {
-        if (aeron_context_init(&g_context) < 0)
-        {
-            setErrorFromAeron("aeron_context_init failed (publisher)");
-            return 0;
-        }
+    std::lock_guard<std::mutex> lock(g_snapControlMutex);
+    stopStateSnapshotThread();  // restart with the new interval
+    g_snapStop = false;
+    g_snapThread = std::thread(stateSnapshotLoop, intervalMs);
+    return 1;
+}
 
-        if (!aeronDir.empty())
-        {
-            aeron_context_set_dir(g_context, aeronDir.c_str());
-        }
+void AeronBridge_StopStateSnapshots()
+{
+    std::lock_guard<std::mutex> lock(g_snapControlMutex);
+    stopStateSnapshotThread();
+}
 
-        if (aeron_init(&g_aeron, g_context) < 0)
-        {
-            setErrorFromAeron("aeron_init failed (publisher)");
-            return 0;
-        }
+// ===============================
+// Market-data quotes
+// ===============================
+// AeronBridge_PublishQuoteW only overwrites the symbol's latest-value slot, so
+// OnTick never waits on Aeron. A DLL sender thread wakes every
+// 1 / maxQuotesPerSecond (in microseconds, so rates that do not divide 1000
+// stay exact) and publishes each symbol that changed since its last send: at
+// most one quote per symbol per interval, however fast it ticks. Each round
+// offers its whole batch under one g_pubMux hold; a quote that cannot be
+// offered is marked pending again for the next round.
+static constexpr int MAX_QUOTE_SYMBOLS = 128;
+
+struct QuoteSlot
+{
+    char symbol[MT5_SYMBOL_LEN + 1];
+    double bid;
+    double ask;
+    int64_t timeMsc;
+    int64_t seq;        // updates since the symbol was first seen
+    int32_t pending;    // updates since the last send (0 = nothing to send)
+};
 
-        if (aeron_start(g_aeron) < 0)
-        {
-            setErrorFromAeron("aeron_start failed (publisher)");
-            return 0;
-        }
-    }
+static std::mutex g_quoteMutex;  // guards g_quotes / g_quoteCount
+static QuoteSlot g_quotes[MAX_QUOTE_SYMBOLS];
+static int g_quoteCount = 0;
 
-    // Add publication async
-    if (aeron_async_add_publication(
-        &g_asyncPub,
-        g_aeron,
-        channel.c_str(),
-        streamId) < 0)
+static std::mutex g_quoteControlMutex;  // Start/StopQuotePublisher
+static std::mutex g_quoteWakeMutex;     // g_quoteStop / wakeups
+static std::condition_variable g_quoteCv;
+static std::thread g_quoteThread;
+static bool g_quoteStop = false;
+
+// Caller holds g_quoteMutex. Returns how many frames were written to frames.
+static int collectQuotesLocked(uint8_t (*frames)[QUOTE_FRAME_SIZE], int* slotIndex, int64_t nowNs)
+{
+    int n = 0;
+    for (int i = 0; i < g_quoteCount; i++)
     {
-        setErrorFromAeron("aeron_async_add_publication failed");
-        return 0;
+        QuoteSlot& q = g_quotes[i];
+        if (q.pending == 0) continue;
+
+        uint8_t* f = frames[n];
+        std::memset(f, 0, QUOTE_FRAME_SIZE);
+        wr_u32_le(f + QUOTE_MAGIC_OFFSET, QUOTE_MAGIC);
+        wr_u16_le(f + QUOTE_VERSION_OFFSET, QUOTE_VERSION);
+        wr_i64_le(f + QUOTE_SEND_NS_OFFSET, nowNs);
+        wr_i64_le(f + QUOTE_TIME_MSC_OFFSET, q.timeMsc);
+        wr_f64_le(f + QUOTE_BID_OFFSET, q.bid);
+        wr_f64_le(f + QUOTE_ASK_OFFSET, q.ask);
+        wr_i64_le(f + QUOTE_SEQ_OFFSET, q.seq);
+        wr_i32_le(f + QUOTE_CONFLATED_OFFSET, q.pending);
+        write_ascii_pad0(f + QUOTE_SYMBOL_OFFSET, q.symbol, MT5_SYMBOL_LEN);
+        if (q.pending > 1) counterAdd(CNT_QUOTES_CONFLATED, q.pending - 1);
+        q.pending = 0;
+        slotIndex[n++] = i;
     }
+    return n;
+}
 
-    // Wait for publication to be ready
-    const auto deadline = std::chrono::steady_clock::now() + 
-                         std::chrono::milliseconds(timeoutMs);
-    
-    int pollRes = 0;
-    while (true)
+static void quoteSenderLoop(int intervalUs)
+{
+    static uint8_t frames[MAX_QUOTE_SYMBOLS][QUOTE_FRAME_SIZE];  // sender thread only
+    int slotIndex[MAX_QUOTE_SYMBOLS];
+    bool sent[MAX_QUOTE_SYMBOLS];
+    auto next = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(g_quoteWakeMutex);
+    while (!g_quoteStop)
     {
-        pollRes = aeron_async_add_publication_poll(&g_publication, g_asyncPub);
-        if (pollRes < 0)
+        lock.unlock();
+        int n = 0;
         {
-            setErrorFromAeron("aeron_async_add_publication_poll failed");
-            g_asyncPub = nullptr;
-            return 0;
+            std::lock_guard<std::mutex> quoteLock(g_quoteMutex);
+            n = collectQuotesLocked(frames, slotIndex, wallClockNanos());
         }
-        if (pollRes > 0)
+        int sentCount = 0;
+        if (n > 0)
         {
-            break;  // Ready
+            std::lock_guard<std::mutex> pubLock(g_pubMux);
+            for (int i = 0; i < n; i++)
+            {
+                int ok = 0;
+                for (const auto& ep : g_quotePublications)
+                    ok |= offerToPublication(ep.publication, frames[i], QUOTE_FRAME_SIZE, ORIGIN_PUBLISHER_QUOTE, ep.streamId, &ep.counters);
+                sent[i] = ok != 0;
+                sentCount += ok != 0 ? 1 : 0;
+            }
         }
-
-        if (std::chrono::steady_clock::now() >= deadline)
+        if (sentCount > 0) counterAdd(CNT_QUOTES_SENT, sentCount);
+        if (sentCount < n)
         {
-            setError("Publication timeout: MediaDriver down or channel issue");
-            g_asyncPub = nullptr;
-            return 0;
+            // Not sent: retry next round unless a newer tick already replaced it
+            std::lock_guard<std::mutex> quoteLock(g_quoteMutex);
+            for (int i = 0; i < n; i++)
+            {
+                if (sent[i]) continue;
+                QuoteSlot& q = g_quotes[slotIndex[i]];
+                if (q.pending == 0) q.pending = rd_i32_le(frames[i] + QUOTE_CONFLATED_OFFSET);
+            }
         }
+        lock.lock();
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        next += std::chrono::microseconds(intervalUs);
+        g_quoteCv.wait_until(lock, next, [] { return g_quoteStop; });
     }
-
-    g_pubStarted.store(1);
-    return 1;
 }
 
-int AeronBridge_PublishBinary(const unsigned char* buffer, int bufferLen)
+static void stopQuoteThread()
 {
-    if (!g_publication)
+    if (!g_quoteThread.joinable()) return;
     {
-        setError("Publication not initialized");
-        return 0;
+        std::lock_guard<std::mutex> lock(g_quoteWakeMutex);
+        g_quoteStop = true;
     }
+    g_quoteCv.notify_all();
+    g_quoteThread.join();
+}
 
-    if (!buffer || bufferLen != FRAME_SIZE)
+static void stopQuoteSender()
+{
+    std::lock_guard<std::mutex> lock(g_quoteControlMutex);
+    stopQuoteThread();
+}
+
+int AeronBridge_StartQuotePublisherW(
+    const wchar_t* aeronDirW,
+    const wchar_t* channelW,
+    int streamId,
+    int timeoutMs,
+    int maxQuotesPerSecond)
+{
+    if (maxQuotesPerSecond <= 0 || maxQuotesPerSecond > 1000)
     {
-        setError("PublishBinary: buffer must be exactly 104 bytes");
+        setError("StartQuotePublisher: maxQuotesPerSecond must be 1..1000");
         return 0;
     }
+    if (!startPublisherEndpoint(wide_to_utf8(aeronDirW), wide_to_utf8(channelW), streamId, timeoutMs, "Quote", g_quotePublications))
+        return 0;
 
-    // Attempt to offer the message
-    int64_t result = aeron_publication_offer(
-        g_publication,
-        (const uint8_t*)buffer,
-        (size_t)bufferLen,
-        nullptr,
-        nullptr);
+    std::lock_guard<std::mutex> lock(g_quoteControlMutex);
+    stopQuoteThread();  // restart with the new rate
+    g_quoteStop = false;
+    g_quoteThread = std::thread(quoteSenderLoop, 1000000 / maxQuotesPerSecond);
+    return 1;
+}
 
-    if (result < 0)
+int AeronBridge_PublishQuoteW(const wchar_t* symbolW, double bid, double ask, long long timeMsc)
+{
+    // ASCII copy on the stack: called from OnTick, so no allocation here
+    char symbol[MT5_SYMBOL_LEN + 1];
+    int len = 0;
+    for (; symbolW && symbolW[len] && len < MT5_SYMBOL_LEN; len++)
+        symbol[len] = (symbolW[len] > 0 && symbolW[len] < 0x7F) ? (char)symbolW[len] : '?';
+    symbol[len] = 0;
+    if (len == 0) return 0;
+
+    counterAdd(CNT_QUOTES_UPDATED, 1);
+
+    std::lock_guard<std::mutex> lock(g_quoteMutex);
+    QuoteSlot* q = nullptr;
+    for (int i = 0; i < g_quoteCount; i++)
     {
-        if (result == AERON_PUBLICATION_NOT_CONNECTED)
-        {
-            setError("Publication not connected");
-        }
-        else if (result == AERON_PUBLICATION_BACK_PRESSURED)
-        {
-            setError("Publication back pressured");
-        }
-        else if (result == AERON_PUBLICATION_ADMIN_ACTION)
+        if (std::strcmp(g_quotes[i].symbol, symbol) == 0) { q = &g_quotes[i]; break; }
+    }
+    if (!q)
+    {
+        if (g_quoteCount >= MAX_QUOTE_SYMBOLS)
         {
-            setError("Publication admin action");
+            recordError(ERR_QUOTE_TABLE_FULL, ORIGIN_PUBLISHER_QUOTE, 0, symbol, MAX_QUOTE_SYMBOLS);
+            return 0;
         }
-        else if (result == AERON_PUBLICATION_CLOSED)
+        q = &g_quotes[g_quoteCount++];
+        std::memset(q, 0, sizeof(*q));
+        std::memcpy(q->symbol, symbol, (size_t)len + 1);
+    }
+
+    q->bid = bid;
+    q->ask = ask;
+    q->timeMsc = (int64_t)timeMsc;
+    q->seq++;
+    q->pending++;
+    return 1;
+}
+
+void AeronBridge_StopQuotePublisher()
+{
+    stopQuoteSender();
+    {
+        std::lock_guard<std::mutex> lock(g_pubMux);
+        for (auto& endpoint : g_quotePublications)
         {
-            setError("Publication closed");
+            if (endpoint.publication)
+                aeron_publication_close(endpoint.publication, nullptr, nullptr);
+            closeEndpointCounters(endpoint.counters);
         }
-        else
+        g_quotePublications.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_quoteMutex);
+        g_quoteCount = 0;
+    }
+
+    cleanupAeronContextIfIdle();
+}
+
+void AeronBridge_StopPublisherIpc()
+{
+    {
+        std::lock_guard<std::mutex> lock(g_pubMux);
+        for (auto& endpoint : g_ipcPublications)
         {
-            setErrorFromAeron("aeron_publication_offer failed");
+            if (endpoint.publication)
+                aeron_publication_close(endpoint.publication, nullptr, nullptr);
+            closeEndpointCounters(endpoint.counters);
         }
-        return 0;
+        g_ipcPublications.clear();
     }
 
-    return 1;  // Success
+    g_pubIpcStarted.store(0);
+
+    cleanupAeronContextIfIdle();
 }
 
-void AeronBridge_StopPublisher()
+void AeronBridge_StopPublisherUdp()
 {
-    if (g_publication)
     {
-        aeron_publication_close(g_publication, nullptr, nullptr);
-        g_publication = nullptr;
+        std::lock_guard<std::mutex> lock(g_pubMux);
+        for (auto& endpoint : g_udpPublications)
+        {
+            if (endpoint.publication)
+                aeron_publication_close(endpoint.publication, nullptr, nullptr);
+            closeEndpointCounters(endpoint.counters);
+        }
+        g_udpPublications.clear();
+        g_mdcDestinations.clear();
     }
-    g_asyncPub = nullptr;
-    g_pubStarted.store(0);
+
+    g_pubUdpStarted.store(0);
 
     cleanupAeronContextIfIdle();
 }
 
 // ===============================
-// Dual Publisher API (IPC + UDP)
+// Execution Ack Back-Channel
 // ===============================
 
-int AeronBridge_StartPublisherIpcW(
+int AeronBridge_SetTerminalIdW(const wchar_t* terminalIdW)
+{
+    const std::string terminalId = wide_to_utf8(terminalIdW);
+    if (terminalId.empty() || terminalId.size() > (size_t)TERMINAL_ID_LEN)
+    {
+        setError("SetTerminalId: id must be 1-16 characters");
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(g_ackMutex);
+    std::memcpy(g_terminalId, terminalId.c_str(), terminalId.size() + 1);
+    return 1;
+}
+
+int AeronBridge_StartAckPublisherW(
     const wchar_t* aeronDirW,
     const wchar_t* channelW,
     int streamId,
     int timeoutMs)
 {
-    const std::string aeronDir = wide_to_utf8(aeronDirW);
-    const std::string channel = wide_to_utf8(channelW);
+    return startPublisherEndpoint(wide_to_utf8(aeronDirW), wide_to_utf8(channelW), streamId, timeoutMs, "Ack", g_ackPublications);
+}
 
-    if (!channelLooksValid(channel))
+int AeronBridge_PublishAck(long long signalId, int resultCode, double fillPrice)
+{
+    int64_t publishNs = 0;
+    int64_t receiveNs = 0;
+    if (!lookupDelivered((int64_t)signalId, &publishNs, &receiveNs))
     {
-        setError("Invalid Aeron IPC publisher channel: must start with 'aeron:'");
+        recordError(ERR_ACK_UNKNOWN_SIGNAL, ORIGIN_PUBLISHER_ACK, 0, nullptr, (int64_t)signalId);
         return 0;
     }
-    if (streamId <= 0)
+
+    uint8_t frame[ACK_FRAME_SIZE];
+    std::memset(frame, 0, sizeof(frame));
+    wr_u32_le(frame + ACK_MAGIC_OFFSET, ACK_MAGIC);
+    wr_u16_le(frame + ACK_VERSION_OFFSET, ACK_VERSION);
+    wr_i64_le(frame + ACK_SIGNAL_TS_OFFSET, publishNs);
+    wr_i64_le(frame + ACK_SIGNAL_ID_OFFSET, (int64_t)signalId);
+    wr_u32_le(frame + ACK_RESULT_OFFSET, (uint32_t)resultCode);
+    wr_f64_le(frame + ACK_FILL_PRICE_OFFSET, fillPrice);
+    wr_i64_le(frame + ACK_RECEIVE_NS_OFFSET, receiveNs);
+    wr_i64_le(frame + ACK_ACK_NS_OFFSET, wallClockNanos());
     {
-        setError("Invalid IPC publisher streamId: must be > 0");
-        return 0;
+        std::lock_guard<std::mutex> lock(g_ackMutex);
+        std::memcpy(frame + ACK_TERMINAL_OFFSET, g_terminalId, std::strlen(g_terminalId));
     }
-    if (timeoutMs <= 0) timeoutMs = 3000;
 
+    std::lock_guard<std::mutex> lock(g_pubMux);
+    if (g_ackPublications.empty())
     {
-        std::lock_guard<std::mutex> lock(g_pubMux);
-        if (isPublicationRegistered(g_ipcPublications, channel, streamId))
-            return 1;
+        setError("Ack Publication not initialized");
+        return 0;
     }
 
-    // Initialize Aeron context if not already done
-    if (!g_aeron)
+    int ok = 1;
+    for (const auto& endpoint : g_ackPublications)
     {
-        if (aeron_context_init(&g_context) < 0)
-        {
-            setErrorFromAeron("aeron_context_init failed (IPC publisher)");
-            return 0;
-        }
-
-        if (!aeronDir.empty())
-        {
-            aeron_context_set_dir(g_context, aeronDir.c_str());
-        }
-
-        if (aeron_init(&g_aeron, g_context) < 0)
-        {
-            setErrorFromAeron("aeron_init failed (IPC publisher)");
-            return 0;
-        }
+        if (!offerToPublication(endpoint.publication, frame, sizeof(frame), ORIGIN_PUBLISHER_ACK, endpoint.streamId, &endpoint.counters))
+            ok = 0;
+    }
+    return ok;
+}
 
-        if (aeron_start(g_aeron) < 0)
+void AeronBridge_StopAckPublisher()
+{
+    {
+        std::lock_guard<std::mutex> lock(g_pubMux);
+        for (auto& endpoint : g_ackPublications)
         {
-            setErrorFromAeron("aeron_start failed (IPC publisher)");
-            return 0;
+            if (endpoint.publication)
+                aeron_publication_close(endpoint.publication, nullptr, nullptr);
+            closeEndpointCounters(endpoint.counters);
         }
+        g_ackPublications.clear();
     }
 
-    aeron_async_add_publication_t* asyncPub = nullptr;
-    aeron_publication_t* publication = nullptr;
+    cleanupAeronContextIfIdle();
+}
 
-    // Add publication async
-    if (aeron_async_add_publication(
-        &asyncPub,
-        g_aeron,
-        channel.c_str(),
-        streamId) < 0)
+static void onAckFragment(
+    void* /*clientd*/,
+    const uint8_t* buffer,
+    size_t length,
+    aeron_header_t* /*header*/)
+{
+    if (!buffer || length < (size_t)ACK_FRAME_SIZE) return;
+    if (rd_u32_le(buffer + ACK_MAGIC_OFFSET) != ACK_MAGIC) return;
+    if (rd_u16_le(buffer + ACK_VERSION_OFFSET) != ACK_VERSION) return;
+
+    const int64_t nowNs = wallClockNanos();
+    const int64_t signalTs = rd_i64_le(buffer + ACK_SIGNAL_TS_OFFSET);
+    const int32_t result = rd_i32_le(buffer + ACK_RESULT_OFFSET);
+    const int64_t receiveNs = rd_i64_le(buffer + ACK_RECEIVE_NS_OFFSET);
+    const int64_t ackNs = rd_i64_le(buffer + ACK_ACK_NS_OFFSET);
+
+    char terminalId[TERMINAL_ID_LEN + 1];
+    int n = 0;
+    while (n < TERMINAL_ID_LEN && buffer[ACK_TERMINAL_OFFSET + n] != 0)
     {
-        setErrorFromAeron("aeron_async_add_publication failed (IPC)");
-        return 0;
+        terminalId[n] = (char)buffer[ACK_TERMINAL_OFFSET + n];
+        n++;
     }
+    terminalId[n] = 0;
 
-    // Wait for publication to be ready
-    const auto deadline = std::chrono::steady_clock::now() + 
-                         std::chrono::milliseconds(timeoutMs);
-    
-    int pollRes = 0;
-    while (true)
-    {
-        pollRes = aeron_async_add_publication_poll(&publication, asyncPub);
-        if (pollRes < 0)
-        {
-            setErrorFromAeron("aeron_async_add_publication_poll failed (IPC)");
-            return 0;
-        }
-        if (pollRes > 0)
-        {
-            break;  // Ready
-        }
+    int64_t rttNs = -1;
+    SentSignal& sent = sentSlot(signalTs);
+    if (signalTs != 0 && sent.publishNs.load(std::memory_order_acquire) == signalTs)
+        rttNs = nowNs - sent.sentNs.load(std::memory_order_relaxed);
 
-        if (std::chrono::steady_clock::now() >= deadline)
+    std::lock_guard<std::mutex> lock(g_ackMutex);
+    TerminalAckStats* st = nullptr;
+    for (int i = 0; i < g_ackStatsCount; i++)
+    {
+        if (std::strcmp(g_ackStats[i].terminalId, terminalId) == 0)
         {
-            setError("IPC Publication timeout: MediaDriver down or channel issue");
-            return 0;
+            st = &g_ackStats[i];
+            break;
         }
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
+    if (!st)
+    {
+        if (g_ackStatsCount >= MAX_ACK_TERMINALS) return;
+        st = &g_ackStats[g_ackStatsCount++];
+        std::memset(st, 0, sizeof(*st));
+        std::memcpy(st->terminalId, terminalId, (size_t)n + 1);
+        st->minRttNs = INT64_MAX;
+    }
+
+    st->acks++;
+    if (isTradeRetcodeSuccess(result)) st->ok++;
+    else st->failed++;
 
+    if (rttNs < 0)
     {
-        std::lock_guard<std::mutex> lock(g_pubMux);
-        if (!isPublicationRegistered(g_ipcPublications, channel, streamId))
-        {
-            g_ipcPublications.push_back(PublisherEndpoint{ channel, streamId, publication });
-        }
+        st->unmatched++;
+        return;
     }
 
-    g_pubIpcStarted.store(1);
-    return 1;
+    st->lastRttNs = rttNs;
+    if (rttNs < st->minRttNs) st->minRttNs = rttNs;
+    if (rttNs > st->maxRttNs) st->maxRttNs = rttNs;
+    st->sumRttNs += rttNs;
+    if (receiveNs > 0 && ackNs >= receiveNs)
+        st->sumTerminalNs += ackNs - receiveNs;
 }
 
-int AeronBridge_StartPublisherUdpW(
+int AeronBridge_StartAckSubscriberW(
     const wchar_t* aeronDirW,
     const wchar_t* channelW,
     int streamId,
     int timeoutMs)
 {
+    if (g_ackSubscription) return 1;
+
     const std::string aeronDir = wide_to_utf8(aeronDirW);
     const std::string channel = wide_to_utf8(channelW);
 
     if (!channelLooksValid(channel))
     {
-        setError("Invalid Aeron UDP publisher channel: must start with 'aeron:'");
+        setError("Invalid Aeron ack channel: must start with 'aeron:'");
         return 0;
     }
     if (streamId <= 0)
     {
-        setError("Invalid UDP publisher streamId: must be > 0");
+        setError("Invalid ack streamId: must be > 0");
         return 0;
     }
     if (timeoutMs <= 0) timeoutMs = 3000;
 
-    {
-        std::lock_guard<std::mutex> lock(g_pubMux);
-        if (isPublicationRegistered(g_udpPublications, channel, streamId))
-            return 1;
-    }
-
-    // Initialize Aeron context if not already done
-    if (!g_aeron)
-    {
-        if (aeron_context_init(&g_context) < 0)
-        {
-            setErrorFromAeron("aeron_context_init failed (UDP publisher)");
-            return 0;
-        }
-
-        if (!aeronDir.empty())
-        {
-            aeron_context_set_dir(g_context, aeronDir.c_str());
-        }
-
-        if (aeron_init(&g_aeron, g_context) < 0)
-        {
-            setErrorFromAeron("aeron_init failed (UDP publisher)");
-            return 0;
-        }
-
-        if (aeron_start(g_aeron) < 0)
-        {
-            setErrorFromAeron("aeron_start failed (UDP publisher)");
-            return 0;
-        }
-    }
-
-    aeron_async_add_publication_t* asyncPub = nullptr;
-    aeron_publication_t* publication = nullptr;
+    if (!ensureAeronClient(aeronDir, "ack subscriber"))
+        return 0;
 
-    // Add publication async
-    if (aeron_async_add_publication(
-        &asyncPub,
+    aeron_async_add_subscription_t* asyncSub = nullptr;
+    if (aeron_async_add_subscription(
+        &asyncSub,
         g_aeron,
         channel.c_str(),
-        streamId) < 0)
+        streamId,
+        nullptr, nullptr, nullptr, nullptr) < 0)
     {
-        setErrorFromAeron("aeron_async_add_publication failed (UDP)");
+        setErrorFromAeron("aeron_async_add_subscription failed (ack)");
         return 0;
     }
 
-    // Wait for publication to be ready
-    const auto deadline = std::chrono::steady_clock::now() + 
-                         std::chrono::milliseconds(timeoutMs);
-    
-    int pollRes = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
     while (true)
     {
-        pollRes = aeron_async_add_publication_poll(&publication, asyncPub);
+        const int pollRes = aeron_async_add_subscription_poll(&g_ackSubscription, asyncSub);
         if (pollRes < 0)
         {
-            setErrorFromAeron("aeron_async_add_publication_poll failed (UDP)");
+            setErrorFromAeron("aeron_async_add_subscription_poll failed (ack)");
             return 0;
         }
         if (pollRes > 0)
@@ -1022,143 +6113,70 @@ int AeronBridge_StartPublisherUdpW(
 
         if (std::chrono::steady_clock::now() >= deadline)
         {
-            setError("UDP Publication timeout: MediaDriver down or channel issue");
+            setError("Ack subscribe timeout: MediaDriver down or channel/stream mismatch");
             return 0;
         }
 
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
 
-    {
-        std::lock_guard<std::mutex> lock(g_pubMux);
-        if (!isPublicationRegistered(g_udpPublications, channel, streamId))
-        {
-            g_udpPublications.push_back(PublisherEndpoint{ channel, streamId, publication });
-        }
-    }
-
-    g_pubUdpStarted.store(1);
-    return 1;
-}
-
-int AeronBridge_PublishBinaryIpc(const unsigned char* buffer, int bufferLen)
-{
-    if (!buffer || bufferLen != FRAME_SIZE)
-    {
-        setError("PublishBinaryIpc: buffer must be exactly 104 bytes");
-        return 0;
-    }
-
-    std::vector<PublisherEndpoint> endpoints;
-    {
-        std::lock_guard<std::mutex> lock(g_pubMux);
-        endpoints = g_ipcPublications;
-    }
-
-    if (endpoints.empty())
-    {
-        setError("IPC Publication not initialized");
-        return 0;
-    }
-
-    for (const auto& endpoint : endpoints)
-    {
-        std::string ctx = "IPC Publication streamId=" + std::to_string(endpoint.streamId);
-        if (!offerToPublication(endpoint.publication, (const uint8_t*)buffer, (size_t)bufferLen, ctx.c_str()))
-            return 0;
-    }
-
     return 1;
 }
 
-int AeronBridge_PublishBinaryUdp(const unsigned char* buffer, int bufferLen)
+int AeronBridge_PollAcks()
 {
-    if (!buffer || bufferLen != FRAME_SIZE)
-    {
-        setError("PublishBinaryUdp: buffer must be exactly 104 bytes");
-        return 0;
-    }
-
-    std::vector<PublisherEndpoint> endpoints;
-    {
-        std::lock_guard<std::mutex> lock(g_pubMux);
-        endpoints = g_udpPublications;
-    }
-
-    if (endpoints.empty())
-    {
-        setError("UDP Publication not initialized");
-        return 0;
-    }
-
-    for (const auto& endpoint : endpoints)
-    {
-        std::string ctx = "UDP Publication streamId=" + std::to_string(endpoint.streamId);
-        if (!offerToPublication(endpoint.publication, (const uint8_t*)buffer, (size_t)bufferLen, ctx.c_str()))
-            return 0;
-    }
+    if (!g_ackSubscription) return 0;
 
-    return 1;
+    return (int)aeron_subscription_poll(
+        g_ackSubscription,
+        onAckFragment,
+        nullptr,
+        10);
 }
 
-// Helper: clean up shared Aeron context when nothing is using it
-static void cleanupAeronContextIfIdle()
+int AeronBridge_GetAckStats(unsigned char* outBuf, int outBufLen)
 {
-    bool hasIpcPublications = false;
-    bool hasUdpPublications = false;
-    {
-        std::lock_guard<std::mutex> lock(g_pubMux);
-        hasIpcPublications = !g_ipcPublications.empty();
-        hasUdpPublications = !g_udpPublications.empty();
-    }
+    if (!outBuf || outBufLen <= 1) return 0;
 
-    // Don't close if any publisher or subscriber is still active
-    if (hasIpcPublications || hasUdpPublications || g_publication || g_subscription)
-        return;
+    std::lock_guard<std::mutex> lock(g_ackMutex);
 
-    if (g_aeron)
+    // CSV per line: terminal,acks,ok,failed,unmatched,last_rtt_us,min_rtt_us,avg_rtt_us,max_rtt_us,avg_terminal_us
+    int written = 0;
+    char line[256];
+    for (int i = 0; i < g_ackStatsCount; i++)
     {
-        aeron_close(g_aeron);
-        g_aeron = nullptr;
+        const TerminalAckStats& st = g_ackStats[i];
+        const int64_t matched = st.acks - st.unmatched;
+        const double avgRttUs = matched > 0 ? (double)st.sumRttNs / (double)matched / 1000.0 : 0.0;
+        const double avgTermUs = matched > 0 ? (double)st.sumTerminalNs / (double)matched / 1000.0 : 0.0;
+        const int n = std::snprintf(line, sizeof(line), "%s,%lld,%lld,%lld,%lld,%.1f,%.1f,%.1f,%.1f,%.1f\n",
+            st.terminalId, (long long)st.acks, (long long)st.ok, (long long)st.failed, (long long)st.unmatched,
+            (double)st.lastRttNs / 1000.0,
+            matched > 0 ? (double)st.minRttNs / 1000.0 : 0.0,
+            avgRttUs,
+            (double)st.maxRttNs / 1000.0,
+            avgTermUs);
+        if (n <= 0 || written + n >= outBufLen) break;
+        std::memcpy(outBuf + written, line, (size_t)n);
+        written += n;
     }
 
-    if (g_context)
-    {
-        aeron_context_close(g_context);
-        g_context = nullptr;
-    }
+    outBuf[written] = 0;
+    return written;
 }
 
-void AeronBridge_StopPublisherIpc()
+void AeronBridge_StopAckSubscriber()
 {
+    if (g_ackSubscription)
     {
-        std::lock_guard<std::mutex> lock(g_pubMux);
-        for (auto& endpoint : g_ipcPublications)
-        {
-            if (endpoint.publication)
-                aeron_publication_close(endpoint.publication, nullptr, nullptr);
-        }
-        g_ipcPublications.clear();
+        aeron_subscription_close(g_ackSubscription, nullptr, nullptr);
+        g_ackSubscription = nullptr;
     }
 
-    g_pubIpcStarted.store(0);
-
-    cleanupAeronContextIfIdle();
-}
-
-void AeronBridge_StopPublisherUdp()
-{
     {
-        std::lock_guard<std::mutex> lock(g_pubMux);
-        for (auto& endpoint : g_udpPublications)
-        {
-            if (endpoint.publication)
-                aeron_publication_close(endpoint.publication, nullptr, nullptr);
-        }
-        g_udpPublications.clear();
+        std::lock_guard<std::mutex> lock(g_ackMutex);
+        g_ackStatsCount = 0;
     }
 
-    g_pubUdpStarted.store(0);
-
     cleanupAeronContextIfIdle();
 }
@@ -11,6 +11,8 @@ extern "C" {
     // channel : Aeron URI (e.g. L"aeron:udp?endpoint=239.10.10.1:40123")
     // streamId: stream id (e.g. 1001)
     // timeoutMs: max time to wait for subscription to become available
+    // Also accepts pre-mapped frames from the signal router (AeronSignalRouter.cpp):
+    // subscribe to the profile's IPC stream and mapping is skipped.
     // Returns 1 on success, 0 on failure.
     __declspec(dllexport) int AeronBridge_StartW(
         const wchar_t* aeronDir,
@@ -18,6 +20,34 @@ extern "C" {
         int streamId,
         int timeoutMs);
 
+    // Optional start-up warm-up. Must be called before the first Start (subscriber or
+    // publisher): pre-touch is set on the Aeron context, so once the client exists
+    // the call is refused (returns 0, error set) and nothing changes.
+    // syntheticFrames > 0: the Aeron client pre-touches every log buffer it maps, and
+    // StartW pushes that many synthetic frames through decode / mapping / lane slots.
+    // Synthetic frames are never delivered, broadcast, netted, rate limited or traced,
+    // and take no signal ids. Counters 39-41 compare the first live signal's decode
+    // latency with the steady state.
+    // 0 = off (default); capped at 100000. Returns 1 on success.
+    __declspec(dllexport) int AeronBridge_SetWarmup(int syntheticFrames);
+
+    // Instrument-sharded streams (off by default). Use the same map on publisher
+    // and subscriber terminals, e.g. L"ES=1101,MES=1101,NQ=1102,*=1100"; "*" is
+    // the stream for prefixes without their own entry. Without "*" those stay on
+    // the streams that are not shards (the start call's streamId).
+    // Publisher: StartPublisherIpcW/UdpW also open an endpoint per shard stream
+    // on the same channel, and PublishBinaryIpc/Udp (and state snapshots) offer a
+    // frame only to its shard's endpoints. Heartbeats still go to every stream.
+    // Subscriber: StartW subscribes only to the shards of the registered mappings
+    // (every mapping if none were registered; every shard with unmapped
+    // pass-through on). Set the map and mappings before StartW / publisher start.
+    // Up to 64 prefixes and 16 streams; empty = off. Returns 1, 0 on a parse error.
+    __declspec(dllexport) int AeronBridge_SetShardMapW(const wchar_t* shardMap);
+
+    // Streams the running subscriber polls, comma-separated (first = primary).
+    // Returns bytes written.
+    __declspec(dllexport) int AeronBridge_GetSubscribedStreams(unsigned char* outBuf, int outBufLen);
+
     // Optional: register/override mapping + tick conversion rules
     // futPrefix: "ES", "NQ", etc.
     // mt5Symbol: "SPX500", "NAS100", etc.
@@ -30,6 +60,33 @@ extern "C" {
         double futTickSize,
         double mt5PointSize);
 
+    // Per-mapping transform chain, run at decode so the EA gets a final instruction.
+    // Order: action remap, reversal, qty scaling, SL/PT clamp. The mapping must exist
+    // (built-in default or RegisterInstrumentMapW); re-registering keeps transforms.
+    // futPrefix "*" applies to every mapping registered so far; set it before per-prefix ones.
+    // qtyMultiplier: > 0, applied to qty (1.0 = unchanged); a sized signal stays >= 1
+    // qtyRounding  : 0 = nearest, 1 = down, 2 = up
+    // min/max SL and PT points: clamp a set SL/PT (0 = no limit; an unset SL/PT stays 0)
+    // reverse      : 1 = swap long/short (1<->3, 2<->4, 5<->6, 7<->8), distances kept
+    // Returns 1 on success, 0 on invalid args or unknown prefix.
+    __declspec(dllexport) int AeronBridge_SetMappingTransformW(
+        const wchar_t* futPrefix,
+        double qtyMultiplier,
+        int qtyRounding,
+        int minSlPoints,
+        int maxSlPoints,
+        int minPtPoints,
+        int maxPtPoints,
+        int reverse);
+
+    // Remap one incoming action (1..10) to another before reversal; toAction 0 clears.
+    // futPrefix "*" applies to every mapping registered so far.
+    // Returns 1 on success, 0 on invalid args or unknown prefix.
+    __declspec(dllexport) int AeronBridge_SetActionRemapW(
+        const wchar_t* futPrefix,
+        int fromAction,
+        int toAction);
+
     // Configure unmapped symbol behavior
     // allowUnmapped: 1 = pass-through unmapped symbols with prefix as symbol, 0 = drop them (default)
     // defaultTickSize: tick size to use for unmapped instruments (e.g. 0.01)
@@ -43,6 +100,49 @@ extern "C" {
     // Poll Aeron (call on timer/tick).
     __declspec(dllexport) int AeronBridge_Poll();
 
+    // Poll with a work and time budget (controlled poll).
+    // maxFragments: upper bound on fragments consumed (<= 0 -> 10)
+    // maxMicros   : time budget for this call (0 = none)
+    // Stops early, leaving the remaining fragments in the term buffer for the next
+    // call, when the time budget is spent or any signal lane is full (checked
+    // before the frame is decoded, so a held-back signal is not lost; drain with
+    // GetSignalCsv and poll again).
+    // Returns fragments consumed; details via AeronBridge_LastPollStat.
+    __declspec(dllexport) int AeronBridge_PollBudget(int maxFragments, int maxMicros);
+
+    // Detail of this thread's last PollBudget call:
+    // 0 fragments consumed, 1 signals enqueued,
+    // 2 stop reason (0 limit/empty, 1 time budget, 2 lane full), 3 elapsed micros,
+    // 4 signals dropped or evicted by a full lane.
+    __declspec(dllexport) long long AeronBridge_LastPollStat(int stat);
+
+    // Per-publisher image (session) on the signal subscription, newline-separated CSV:
+    // session_id,source,correlation_id,active,join_ns,leave_ns,join_position,
+    // position,lag,max_lag,rejoins,end_of_stream
+    // lag = publisher side position (UDP receiver high-water mark / IPC publisher
+    // position) - our position, in bytes; -1 if the driver counter was not found.
+    // rejoins counts earlier images from the same source (image rebuilds);
+    // end_of_stream=0 on a left image means it timed out rather than closed cleanly.
+    // A growing lag means Poll is not called often enough to keep up.
+    // Returns bytes written.
+    __declspec(dllexport) int AeronBridge_GetImageStats(unsigned char* outBuf, int outBufLen);
+
+    // Publisher liveness from heartbeat frames (see AeronBridge_StartHeartbeatW).
+    // A source/session is stale when no heartbeat arrived within timeoutMs
+    // (0 = 3x the interval the publisher advertises, the default); going stale
+    // raises one SOURCE STALE error event. Checked from Poll every millisecond.
+    // Returns 1 on success, 0 on invalid args.
+    __declspec(dllexport) int AeronBridge_SetLivenessTimeout(int timeoutMs);
+
+    // Liveness table as newline-separated CSV lines:
+    // source,session_id,alive,age_ms,interval_ms,beats,missed,stale_events,last_sender_ns
+    // missed = heartbeat sequence gaps. Returns bytes written.
+    __declspec(dllexport) int AeronBridge_GetLiveness(unsigned char* outBuf, int outBufLen);
+
+    // Returns 1 if any session of source is alive, 0 if all are stale,
+    // -1 if no heartbeat was ever received from it.
+    __declspec(dllexport) int AeronBridge_IsSourceAliveW(const wchar_t* source);
+
     // Returns 1 if a *valid* signal is ready (after filtering + mapping), else 0.
     __declspec(dllexport) int AeronBridge_HasSignal();
 
@@ -52,12 +152,217 @@ extern "C" {
     // Returns bytes written (excluding null terminator), 0 if none.
     __declspec(dllexport) int AeronBridge_GetSignalCsv(unsigned char* outBuf, int outBufLen);
 
-    // Stop/cleanup
+    // Drain up to maxSignals signals (<= 0 = all that fit) in priority order as
+    // newline-separated lines: the GetSignalCsv CSV plus a trailing signal_id field.
+    // Returns bytes written (excluding null terminator), 0 if none.
+    __declspec(dllexport) int AeronBridge_GetSignalBatchCsv(unsigned char* outBuf, int outBufLen, int maxSignals);
+
+    // Signals are queued in priority lanes and always drained highest lane first:
+    // lane 0 = force exit (10), lane 1 = risk (exits/stop-loss/profit target 5..9),
+    // lane 2 = entries (1..4).
+    // capacity  : slots in the lane (defaults 32 / 64 / 100)
+    // dropPolicy: 0 = drop incoming when full, 1 = evict oldest (defaults 1 / 1 / 0)
+    // Must be called while the lane is empty. Returns 1 on success, 0 on invalid args.
+    __declspec(dllexport) int AeronBridge_ConfigureLane(int lane, int capacity, int dropPolicy);
+
+    // Time-to-live per lane (0 = never expire, the default). Checked against the
+    // frame timestamp when the signal arrives and again when it is dequeued;
+    // expired signals are discarded before formatting or delivery.
+    // Returns 1 on success, 0 on invalid args.
+    __declspec(dllexport) int AeronBridge_SetSignalTtl(int lane, int ttlMs);
+
+    // Clock-skew handling for TTL checks.
+    // publisherClockOffsetMs: added to frame timestamps to bring them into local UTC
+    // maxFutureSkewMs       : frames further ahead than this use the local receive
+    //                         time instead (default 1000)
+    // Returns 1 on success, 0 on invalid args.
+    __declspec(dllexport) int AeronBridge_SetClockSkew(int publisherClockOffsetMs, int maxFutureSkewMs);
+
+    // Token-bucket rate limits, checked on the raw frame before the signal state
+    // table, the exit filter and decode/mapping (a shed frame changes nothing).
+    // scope     : 0 = per source, 1 = per instrument
+    // key       : source / instrument name, empty = default for every key of the scope
+    // ratePerSec: sustained frames per second, 0 = unlimited
+    // burst     : bucket size in frames (0 = max(ratePerSec, 1))
+    // A frame needs a token from both its source and its instrument bucket.
+    // Excess frames are dropped; the first drop per bucket raises a RATE LIMITED
+    // error and sets a sticky alarm. Force exits (10) are never dropped.
+    // Up to 128 keyed buckets; beyond that, new keys of a scope share one overflow
+    // bucket (key "*") on the scope default, which raises a RATE LIMIT TABLE FULL
+    // error and sets its alarm (counter 42).
+    // Returns 1 on success, 0 on invalid args.
+    __declspec(dllexport) int AeronBridge_SetRateLimitW(int scope, const wchar_t* key, double ratePerSec, int burst);
+
+    // Rate limit buckets as newline-separated CSV lines:
+    // scope,key,rate_per_sec,burst,tokens,passed,shed,alarm
+    __declspec(dllexport) int AeronBridge_GetRateLimitStats(unsigned char* outBuf, int outBufLen);
+
+    // Clears sticky rate alarms. Returns the number of alarms that were set.
+    __declspec(dllexport) int AeronBridge_ClearRateAlarms();
+
+    // Trading-session calendar per futures prefix, evaluated at decode on the final
+    // action. Entries (1-4) outside a session are dropped before formatting;
+    // exits, stop-loss / profit target and force exits always pass.
+    // schedule: comma-separated "day=HH:MM-HH:MM" or "mon-fri=HH:MM-HH:MM" in the
+    //           exchange's local time (sun..sat); start > end runs past midnight,
+    //           e.g. L"sun-thu=18:00-17:00". Empty removes the calendar.
+    // utcOffsetMinutes  : local = UTC + offset (e.g. -300 for EST, -240 for EDT);
+    //                     set the calendar again when DST changes
+    // closeBufferMinutes: entries within this many minutes of a session end are
+    //                     handled by nearClosePolicy (0 = only gate outside sessions)
+    // nearClosePolicy   : 0 = drop them, 1 = convert them to AERON_FORCE_EXIT (10)
+    // Returns 1 on success, 0 on a parse error or full table (32 instruments).
+    __declspec(dllexport) int AeronBridge_SetSessionCalendarW(
+        const wchar_t* futPrefix,
+        const wchar_t* schedule,
+        int utcOffsetMinutes,
+        int closeBufferMinutes,
+        int nearClosePolicy);
+
+    // 1 inside a session, 0 outside, -1 if no calendar is set for the prefix.
+    __declspec(dllexport) int AeronBridge_IsInSessionW(const wchar_t* futPrefix);
+
+    // Session calendars as newline-separated CSV lines:
+    // prefix,windows,in_session,minutes_to_close,close_buffer_min,policy,gated,converted
+    // minutes_to_close is -1 outside a session. Returns bytes written.
+    __declspec(dllexport) int AeronBridge_GetSessionStats(unsigned char* outBuf, int outBufLen);
+
+    // Latest state per (source, instrument), updated from every received frame
+    // (exits 5/6 included) and seeded from publisher state snapshots (see
+    // AeronBridge_StartStateSnapshots), so an EA started mid-session can
+    // reconcile at once. Newline-separated CSV lines:
+    // source,instrument,last_action,last_ns,entry_action,entry_qty,entry_ns,
+    // direction,mt5_symbol,mt5_direction,mt5_qty,frames,seeded
+    // direction: +1 long, -1 short, 0 flat, as the source last signalled it.
+    // mt5_direction / mt5_qty: the same position after this terminal's mapping
+    // transforms. frames counts live frames; seeded = 1 if the latest update
+    // came from a snapshot. Up to 128 keys. Returns bytes written.
+    __declspec(dllexport) int AeronBridge_GetSignalState(unsigned char* outBuf, int outBufLen);
+
+    // Netting window per MT5 symbol (off by default). Entries (1-4) received within
+    // windowMs of the first one supersede each other: when the window closes one
+    // entry goes out in the newest direction, with the newest entry's SL/PT and the
+    // summed qty of the same-direction entries since the last reversal (long 1 then
+    // short 1 delivers short 1; long 1, long 2 delivers long 3). Stop-loss/profit
+    // target release the pending entry at once; force exit drops it.
+    // 0 = off, flushes pending. Returns 1 on success, 0 on invalid args.
+    __declspec(dllexport) int AeronBridge_SetNettingWindow(int windowMs);
+
+    // Broadcast consumers: every registered consumer sees every signal (in arrival
+    // order) through its own cursor, independent of GetSignalCsv and of each other.
+    // lapPolicy: when a consumer falls more than 1024 signals behind,
+    //            0 = resume at the oldest retained signal, 1 = skip to the newest.
+    // Re-registering the same name (EA reload) returns the same id and keeps its cursor.
+    // Returns consumer id (1-16), 0 on failure.
+    __declspec(dllexport) int AeronBridge_RegisterConsumerW(const wchar_t* name, int lapPolicy);
+
+    // Release a consumer id. Returns 1 on success, 0 if not registered.
+    __declspec(dllexport) int AeronBridge_UnregisterConsumer(int consumerId);
+
+    // Next signal for this consumer (same CSV as GetSignalCsv); sets LastSignalId and
+    // LastSignalMerged. Signals past their lane TTL are skipped and counted as expired.
+    // Returns bytes written, 0 if none.
+    __declspec(dllexport) int AeronBridge_GetConsumerSignalCsv(int consumerId, unsigned char* outBuf, int outBufLen);
+
+    // Per-consumer statistics as newline-separated CSV lines:
+    // id,name,lap_policy,backlog,delivered,lapped,lap_events,expired
+    __declspec(dllexport) int AeronBridge_GetConsumerStats(unsigned char* outBuf, int outBufLen);
+
+    // Per-lane statistics as newline-separated CSV lines:
+    // lane,name,capacity,drop_policy,depth,hwm,enqueued,delivered,dropped,inversions_avoided,ttl_ms,expired
+    // inversions_avoided counts dequeues that plain FIFO would have made wait behind
+    // an older lower-priority signal. Returns bytes written.
+    __declspec(dllexport) int AeronBridge_GetLaneStats(unsigned char* outBuf, int outBufLen);
+
+    // Id of the signal most recently returned by AeronBridge_GetSignalCsv on the
+    // calling thread (0 if none). Ids are monotonic per DLL load.
+    __declspec(dllexport) long long AeronBridge_LastSignalId();
+
+    // UTC time in nanoseconds from the DLL's calibrated clock (high-resolution
+    // monotonic clock anchored to system time, re-synced every second).
+    // Monotonic per calling thread. Use for frame timestamps.
+    __declspec(dllexport) long long AeronBridge_NowNanos();
+
+    // Number of source signals merged into the signal most recently returned on
+    // the calling thread (1 = not netted, 0 if none).
+    __declspec(dllexport) int AeronBridge_LastSignalMerged();
+
+    // Per-signal stage tracing (off by default).
+    // enabled : 1 = on, 0 = off (recorded data is kept for AeronBridge_DumpTraceW)
+    // capacity: number of signals kept (ring, preallocated here), <= 0 = 4096
+    // Stages: 0 = receive, 1 = mapped, 2 = enqueued, 3 = dequeued (GetSignalCsv),
+    //         4..7 = EA-defined, reported with AeronBridge_MarkSignal.
+    // Returns 1 on success, 0 on invalid args.
+    __declspec(dllexport) int AeronBridge_SetTracing(int enabled, int capacity);
+
+    // Stamp an EA stage (4..7) for a signal id, e.g. 4 = order sent, 5 = order filled.
+    // Returns 1 if recorded, 0 if tracing is off or the id is no longer in the ring.
+    __declspec(dllexport) int AeronBridge_MarkSignal(long long signalId, int stage);
+
+    // Write the traced signals as Chrome trace-event JSON (chrome://tracing, Perfetto).
+    // Each signal is an async track with transport/decode_map/enqueue/queue_wait/ea_stage_N slices.
+    // Returns number of signals written, 0 on failure.
+    __declspec(dllexport) int AeronBridge_DumpTraceW(const wchar_t* path);
+
+    // Read a bridge counter (also registered in the Aeron CnC file as type 1601,
+    // label "AeronBridge pid=<pid>: <name>", visible to AeronStat while a client is up).
+    // 0 fragments polled, 1 rejected (length), 2 rejected (magic), 3 rejected (version),
+    // 4 exits filtered, 5 unmapped drops, 6 queue full drops, 7 signals enqueued,
+    // 8 signals delivered, 9 queue depth high-water mark, 10 publish ok,
+    // 11 publish failed, 12 publish back pressured, 13 expired at enqueue,
+    // 14 expired at dequeue, 15 frame timestamps beyond skew tolerance,
+    // 16 images joined, 17 images left, 18 image lag max bytes,
+    // 19 polls that hit the fragment limit or budget, 20 signals merged by netting,
+    // 21 netting windows reversed by an opposite entry, 22 clock re-sync max correction ns,
+    // 23 heartbeats sent, 24 heartbeats received, 25 sources gone stale,
+    // 26 signals restored from shared memory, 27 starts restored from a persisted
+    // snapshot, 28 bytes skipped by images rejoining after a reload,
+    // 29 frames shed by rate limits, 30 signals altered by mapping transforms,
+    // 31 synthetic warm-up frames, 32 quote updates from the EA, 33 quotes published,
+    // 34 quote updates conflated, 35 entries gated by session calendar,
+    // 36 entries converted to force exit near session close, 37 state snapshots
+    // sent, 38 state entries seeded from snapshots, 39 decode ns of the first
+    // signal frame after StartW, 40 steady-state decode ns total, 41 steady-state
+    // signal frames decoded (mean = 40 / 41), 42 frames limited by a rate overflow
+    // bucket.
+    // Per-endpoint publish ok/failed/back pressured counters are registered per stream.
+    // Returns -1 for an unknown id.
+    __declspec(dllexport) long long AeronBridge_GetCounter(int counterId);
+
+    // Stop/cleanup: closes the subscription, and the Aeron client when no publisher
+    // uses it. With persistence on, the queue is snapshotted first
+    // (see AeronBridge_SetPersistence).
     __declspec(dllexport) void AeronBridge_Stop();
 
+    // Keep undelivered signals across EA reloads (off by default). When on,
+    // AeronBridge_Stop snapshots the queue and image positions into a named
+    // shared-memory segment that lives until the terminal exits, then closes the
+    // subscription and client as usual (nothing keeps running after OnDeinit, so
+    // the DLL can unload safely). A StartW for the same channel/stream, also from
+    // a reloaded DLL, restores the queue (TTL still applies) and resubscribes at
+    // the live position: signals published while stopped are not replayed, the
+    // skipped bytes show in counter 28. Call before StartW in OnInit.
+    // 0 = off: discards the snapshot.
+    // Returns 1 on success, 0 if the segment cannot be mapped.
+    __declspec(dllexport) int AeronBridge_SetPersistence(int enabled);
+
     // Copies last error string into outBuf (UTF-8 bytes). Returns bytes written.
     __declspec(dllexport) int AeronBridge_LastError(unsigned char* outBuf, int outBufLen);
 
+    // Drain queued error events (oldest first) as newline-separated CSV lines:
+    // timestamp_ns,code,stream_id,instrument,detail,suppressed,message
+    // Events are recorded lock-free on the hot path; text is formatted here.
+    // maxEvents: max events to drain (<= 0 = all that fit)
+    // Returns bytes written (excluding null terminator), 0 if none.
+    // Events that do not fit in outBuf stay queued for the next call.
+    __declspec(dllexport) int AeronBridge_GetErrors(unsigned char* outBuf, int outBufLen, int maxEvents);
+
+    // Per-code rate limit for error events (default 20/s per code, 0 = unlimited).
+    // Suppressed events are counted in the next event of the same code. Text
+    // errors from start/configuration calls are never suppressed.
+    // Returns 1 on success, 0 on invalid args.
+    __declspec(dllexport) int AeronBridge_SetErrorRateLimit(int maxPerCodePerSecond);
+
     // ===============================
     // Publisher API (Aeron Producer)
     // ===============================
@@ -75,7 +380,8 @@ extern "C" {
         int timeoutMs);
 
     // Publish a binary signal message (104 bytes, same format as subscriber)
-    // buffer: 104-byte binary message in the protocol format
+    // buffer: 104-byte binary message in the protocol format; a zero timestamp
+    //         is stamped with AeronBridge_NowNanos at send time (all publish calls)
     // Returns 1 on success, 0 on failure.
     __declspec(dllexport) int AeronBridge_PublishBinary(
         const unsigned char* buffer,
@@ -112,12 +418,169 @@ extern "C" {
         const unsigned char* buffer,
         int bufferLen);
 
+    // Start a multi-destination-cast (MDC) UDP publication: one publication and
+    // one offer fan out to every destination, instead of one publication per stream.
+    // controlEndpoint: empty = manual mode (add destinations below),
+    //                  "host:port" = dynamic mode (subscribers join via control endpoint)
+    // Joins the UDP publisher set, so AeronBridge_PublishBinaryUdp offers to it.
+    // Returns 1 on success, 0 on failure.
+    __declspec(dllexport) int AeronBridge_StartPublisherMdcW(
+        const wchar_t* aeronDir,
+        const wchar_t* controlEndpoint,
+        int streamId,
+        int timeoutMs);
+
+    // Add/remove a destination ("host:port") on the manual MDC publication for streamId.
+    // Safe to call while publishing; adding an existing destination is a no-op.
+    // Returns 1 on success, 0 on failure.
+    __declspec(dllexport) int AeronBridge_AddPublisherDestinationW(int streamId, const wchar_t* endpoint);
+    __declspec(dllexport) int AeronBridge_RemovePublisherDestinationW(int streamId, const wchar_t* endpoint);
+
+    // Current manual MDC destinations for streamId, one host:port per line.
+    // Returns bytes written (0 if none).
+    __declspec(dllexport) int AeronBridge_GetPublisherDestinations(int streamId, unsigned char* outBuf, int outBufLen);
+
+    // Flow-control health of every publication (legacy, IPC, UDP/MDC, ack, quote) as
+    // newline-separated CSV lines:
+    // kind,stream_id,session_id,connected,position,position_limit,window,term_length,channel_status,channel
+    // window = position_limit - position: bytes that can be offered before
+    // BACK_PRESSURED. channel_status: 1 active, 0 initializing, -1 errored.
+    // Returns bytes written.
+    __declspec(dllexport) int AeronBridge_GetPublisherHealth(unsigned char* outBuf, int outBufLen);
+
+    // Smallest remaining window (bytes) across connected publications on streamId
+    // (0 = all streams). Returns -1 if none is connected.
+    __declspec(dllexport) long long AeronBridge_GetPublisherWindow(int streamId);
+
+    // Mapped memory per endpoint (publications and active subscriber images) as
+    // newline-separated CSV lines:
+    // kind,stream_id,session_id,term_length,mtu,mapped_bytes,channel
+    // mapped_bytes = 3 terms + metadata page; channel is the source for images.
+    // Last line: total,0,0,0,0,<mapped bytes of all endpoints>,
+    // Returns bytes written.
+    __declspec(dllexport) int AeronBridge_GetMemoryReport(unsigned char* outBuf, int outBufLen);
+
+    // Total mapped bytes across all endpoints (same sum as the report's total line).
+    __declspec(dllexport) long long AeronBridge_GetMappedBytes();
+
+    // Heartbeats: a DLL thread publishes a heartbeat frame for source every
+    // intervalMs on every signal publication (legacy, IPC, UDP/MDC), so
+    // subscribers can tell a quiet publisher from a dead one. Calling again
+    // restarts with the new settings. Call AeronBridge_StopHeartbeat in OnDeinit;
+    // the thread also stops when the last signal publication is closed, so start
+    // it after the publisher. Returns 1 on success, 0 on invalid args.
+    __declspec(dllexport) int AeronBridge_StartHeartbeatW(const wchar_t* source, int intervalMs);
+    __declspec(dllexport) void AeronBridge_StopHeartbeat();
+
+    // State snapshots: a DLL thread re-sends the last frame published per
+    // (source, instrument) every intervalMs as a state frame (120 bytes LE:
+    // magic 0xA3305EED, version, flags, snapshot ns, the 104-byte signal frame)
+    // on every signal publication. Subscribers seed AeronBridge_GetSignalState
+    // from them and never queue them. Calling again restarts with the new
+    // interval. Like heartbeats, the thread stops when the last signal
+    // publication is closed. Returns 1 on success, 0 on invalid args.
+    __declspec(dllexport) int AeronBridge_StartStateSnapshots(int intervalMs);
+    __declspec(dllexport) void AeronBridge_StopStateSnapshots();
+
+    // Market-data quotes (broker CFD bid/ask for the futures side). Quote frame,
+    // 88 bytes LE: magic 0xA330B1DA, version, send ns, MT5 time msc, bid, ask,
+    // per-symbol seq, conflated tick count, symbol char[32].
+    // StartQuotePublisherW starts a dedicated publication and a DLL sender thread
+    // that publishes each changed symbol at most maxQuotesPerSecond (1..1000)
+    // times per second; calling again restarts the sender with the new rate.
+    // Returns 1 on success, 0 on failure.
+    __declspec(dllexport) int AeronBridge_StartQuotePublisherW(
+        const wchar_t* aeronDir,
+        const wchar_t* channel,
+        int streamId,
+        int timeoutMs,
+        int maxQuotesPerSecond);
+
+    // Record the symbol's latest quote (call from OnTick). Never blocks on Aeron:
+    // ticks between sends are conflated into one quote carrying the latest values.
+    // Up to 128 symbols. Returns 1, or 0 for an empty symbol or a full table.
+    __declspec(dllexport) int AeronBridge_PublishQuoteW(
+        const wchar_t* symbol,
+        double bid,
+        double ask,
+        long long timeMsc);
+
+    // Stop the sender thread and close the quote publication.
+    __declspec(dllexport) void AeronBridge_StopQuotePublisher();
+
+    // Start an IPC or UDP publisher (chosen by the channel prefix) with log buffer
+    // tuning appended to the channel URI. Defaults size terms for bulk data; our
+    // frames are <= 128 bytes, so a small term length saves mapped memory.
+    // termLength: 0 = driver default, else power of two, 64 KiB - 1 GiB
+    // mtu       : 0 = driver default, else multiple of 32, 160 - 65504
+    // sparse    : -1 = driver default, 0 = pre-allocated, 1 = sparse log files
+    // lingerMs  : -1 = driver default, else linger after close
+    // sessionId : 0 = assigned by the driver
+    // Parameters already present in channel must be left at their default.
+    // Returns 1 on success, 0 on failure / invalid tuning.
+    __declspec(dllexport) int AeronBridge_StartPublisherTunedW(
+        const wchar_t* aeronDir,
+        const wchar_t* channel,
+        int streamId,
+        int timeoutMs,
+        int termLength,
+        int mtu,
+        int sparse,
+        int lingerMs,
+        int sessionId);
+
     // Stop/cleanup IPC publisher
     __declspec(dllexport) void AeronBridge_StopPublisherIpc();
 
     // Stop/cleanup UDP publisher
     __declspec(dllexport) void AeronBridge_StopPublisherUdp();
 
+    // ===============================
+    // Execution Ack Back-Channel
+    // ===============================
+    // MT5 terminals acknowledge executed signals; the signal publisher correlates
+    // acks with the frames it sent and reports round-trip latency per terminal.
+    // Ack frame (72 bytes, magic 0xA330ACCE): signal timestamp + id, MT5 retcode,
+    // fill price, bridge receive time, ack time (UTC ns), terminal id char[16].
+
+    // Set this terminal's id (1-16 ASCII chars) carried in every ack.
+    __declspec(dllexport) int AeronBridge_SetTerminalIdW(const wchar_t* terminalId);
+
+    // Start an ack publication (subscriber/MT5 side). Multiple endpoints allowed.
+    __declspec(dllexport) int AeronBridge_StartAckPublisherW(
+        const wchar_t* aeronDir,
+        const wchar_t* channel,
+        int streamId,
+        int timeoutMs);
+
+    // Publish an ack for a signal id (AeronBridge_LastSignalId after GetSignalCsv).
+    // resultCode: MT5 trade retcode (10008/10009/10010 count as success).
+    // Returns 1 on success, 0 on failure (see AeronBridge_GetErrors).
+    __declspec(dllexport) int AeronBridge_PublishAck(long long signalId, int resultCode, double fillPrice);
+
+    // Stop/cleanup ack publications
+    __declspec(dllexport) void AeronBridge_StopAckPublisher();
+
+    // Subscribe to acks (signal publisher side). Frames published through
+    // AeronBridge_PublishBinary* are remembered so acks can be correlated.
+    __declspec(dllexport) int AeronBridge_StartAckSubscriberW(
+        const wchar_t* aeronDir,
+        const wchar_t* channel,
+        int streamId,
+        int timeoutMs);
+
+    // Poll ack subscription (call on timer). Returns fragments processed.
+    __declspec(dllexport) int AeronBridge_PollAcks();
+
+    // Per-terminal ack statistics as newline-separated CSV lines:
+    // terminal,acks,ok,failed,unmatched,last_rtt_us,min_rtt_us,avg_rtt_us,max_rtt_us,avg_terminal_us
+    // rtt = local send -> ack received (same clock); terminal = bridge receive -> ack (terminal clock).
+    // Returns bytes written (excluding null terminator).
+    __declspec(dllexport) int AeronBridge_GetAckStats(unsigned char* outBuf, int outBufLen);
+
+    // Stop/cleanup ack subscription and reset statistics
+    __declspec(dllexport) void AeronBridge_StopAckSubscriber();
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,158 @@
+// AeronBridgeAllocTest.cpp — steady-state allocation check for AeronBridge.cpp.
+//
+// Builds the bridge into a console program against AeronClientStub.cpp, replaces
+// the global allocator with a counting one, warms up, then drives a large
+// synthetic workload through Poll -> onFragment -> lane enqueue -> GetSignalCsv
+// dequeue -> PublishBinaryIpc. Any heap allocation in that loop fails the run
+// (exit code 1), which fails the solution build through the post-build step.
+
+#include "AeronBridge.h"
+#include "AeronBridgeCore.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+void aeronStubSetFeed(const uint8_t* frames, size_t frameSize, size_t count);
+size_t aeronStubPending();
+int64_t aeronStubOffers();
+
+// ===============================
+// Counting allocator
+// ===============================
+static std::atomic<bool> g_counting{ false };
+static std::atomic<long long> g_allocations{ 0 };
+
+static void* countedAlloc(size_t size)
+{
+    if (g_counting.load(std::memory_order_relaxed))
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new(size_t size)
+{
+    if (void* p = countedAlloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    if (void* p = countedAlloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+// ===============================
+// Workload
+// ===============================
+static const int WARMUP_FRAMES = 1000;
+static const int MEASURED_FRAMES = 200000;
+
+static void encodeSignal(uint8_t* out, uint16_t action, int32_t qty, const char* instrument)
+{
+    std::memset(out, 0, FRAME_SIZE);
+    wr_u32_le(out + MAGIC_OFFSET, MAGIC);
+    wr_u16_le(out + VERSION_OFFSET, VERSION);
+    wr_u16_le(out + ACTION_OFFSET, action);
+    wr_i64_le(out + TIMESTAMP_OFFSET, 0);
+    wr_i32_le(out + LONG_SL_OFFSET, 10);
+    wr_i32_le(out + SHORT_SL_OFFSET, 10);
+    wr_i32_le(out + PROFIT_TARGET_OFFSET, 20);
+    wr_i32_le(out + QTY_OFFSET, qty);
+    wr_f32_le(out + CONFIDENCE_OFFSET, 0.9f);
+    write_ascii_pad0(out + SYMBOL_OFFSET, "ES", SYMBOL_LEN);
+    write_ascii_pad0(out + INSTRUMENT_OFFSET, instrument, INSTRUMENT_LEN);
+    write_ascii_pad0(out + SOURCE_OFFSET, "ALLOCTEST", SOURCE_LEN);
+}
+
+// Alternates entries and exits across mapped, long-named and unmapped instruments
+// so mapping, transforms, lane routing and rejection paths all run.
+static std::vector<uint8_t> buildFeed(int frames)
+{
+    static const char* const instruments[] = { "ES MAR26", "ES JUN26 WITH A LONG NAME", "NQ MAR26", "GC APR26" };
+    static const uint16_t actions[] = { 1, 2, 3, 1, 5, 2, 6, 4 };
+    std::vector<uint8_t> feed((size_t)frames * FRAME_SIZE);
+    for (int i = 0; i < frames; ++i)
+        encodeSignal(&feed[(size_t)i * FRAME_SIZE], actions[i % 8], 1 + (i % 3), instruments[i % 4]);
+    return feed;
+}
+
+// One Poll -> drain -> publish round per call; returns signals dequeued.
+static long long runRounds(unsigned char* out, int outLen, const uint8_t* publishFrame)
+{
+    long long delivered = 0;
+    while (aeronStubPending() > 0)
+    {
+        AeronBridge_Poll();
+        AeronBridge_PollBudget(32, 0);
+        while (AeronBridge_GetSignalCsv(out, outLen) > 0)
+            ++delivered;
+        AeronBridge_PublishBinaryIpc(publishFrame, FRAME_SIZE);
+    }
+    return delivered;
+}
+
+int main()
+{
+    AeronBridge_SetWarmup(WARMUP_FRAMES);
+    AeronBridge_RegisterInstrumentMapW(L"ES", L"A_VERY_LONG_BROKER_SYMBOL_NAME_X64", 0.25, 0.01);
+    AeronBridge_RegisterInstrumentMapW(L"NQ", L"NAS100", 0.25, 0.01);
+    AeronBridge_SetMappingTransformW(L"ES", 2, 0, 0, 0, 0, 0, 0);
+
+    if (!AeronBridge_StartW(L"", L"aeron:ipc", 1001, 100) ||
+        !AeronBridge_StartPublisherIpcW(L"", L"aeron:ipc", 2001, 100))
+    {
+        std::printf("FAIL: bridge did not start\n");
+        return 1;
+    }
+
+    unsigned char out[4096];
+    uint8_t publishFrame[FRAME_SIZE];
+    encodeSignal(publishFrame, 1, 1, "ES MAR26");
+
+    // Warm-up: first touch of per-thread state, lanes and publication buffers.
+    const std::vector<uint8_t> warm = buildFeed(WARMUP_FRAMES);
+    aeronStubSetFeed(warm.data(), FRAME_SIZE, WARMUP_FRAMES);
+    runRounds(out, sizeof(out), publishFrame);
+
+    const std::vector<uint8_t> feed = buildFeed(MEASURED_FRAMES);
+    aeronStubSetFeed(feed.data(), FRAME_SIZE, MEASURED_FRAMES);
+    const int64_t offersBefore = aeronStubOffers();
+
+    g_counting.store(true);
+    const long long delivered = runRounds(out, sizeof(out), publishFrame);
+    g_counting.store(false);
+
+    const long long allocations = g_allocations.load();
+    std::printf("frames=%d delivered=%lld published=%lld allocations=%lld\n",
+        MEASURED_FRAMES, delivered, (long long)(aeronStubOffers() - offersBefore), allocations);
+
+    AeronBridge_Stop();
+    AeronBridge_StopPublisherIpc();
+
+    if (delivered == 0)
+    {
+        std::printf("FAIL: no signals delivered\n");
+        return 1;
+    }
+    if (allocations != 0)
+    {
+        std::printf("FAIL: %lld heap allocations in steady state\n", allocations);
+        return 1;
+    }
+    std::printf("PASS\n");
+    return 0;
+}
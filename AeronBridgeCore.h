@@ -0,0 +1,409 @@
+#pragma once
+
+// AeronBridgeCore.h — signal frame decode + instrument mapping + tick conversion.
+// Shared by the MT5 bridge DLL (AeronBridge.cpp) and the headless signal router
+// (AeronSignalRouter.cpp). Platform independent: no Windows or Aeron headers.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// ===============================
+// Protocol (must match publisher)
+// ===============================
+// From AeronSignalPublisher.cs / AeronSignalAddon.cs
+static constexpr uint32_t MAGIC = 0xA330BEEF;
+static constexpr uint16_t VERSION = 1;
+static constexpr int FRAME_SIZE = 104;
+
+static constexpr int MAGIC_OFFSET = 0;        // int32
+static constexpr int VERSION_OFFSET = 4;      // int16
+static constexpr int ACTION_OFFSET = 6;       // int16
+static constexpr int TIMESTAMP_OFFSET = 8;    // int64 (ns-ish)
+static constexpr int LONG_SL_OFFSET = 16;     // int32
+static constexpr int SHORT_SL_OFFSET = 20;    // int32
+static constexpr int PROFIT_TARGET_OFFSET = 24;// int32
+static constexpr int QTY_OFFSET = 28;         // int32
+static constexpr int CONFIDENCE_OFFSET = 32;  // float32
+static constexpr int SYMBOL_OFFSET = 36;      // char[16]
+static constexpr int INSTRUMENT_OFFSET = 52;  // char[32]
+static constexpr int SOURCE_OFFSET = 84;      // char[16]
+
+static constexpr int SYMBOL_LEN = 16;
+static constexpr int INSTRUMENT_LEN = 32;
+static constexpr int SOURCE_LEN = 16;
+
+// Routed frame: a signal already mapped for one broker profile by the signal
+// router. SL/PT are MT5 points, the MT5 symbol is resolved; the timestamp is the
+// original publisher timestamp so TTL and ack correlation keep working.
+static constexpr uint32_t ROUTED_MAGIC = 0xA330C0DE;
+static constexpr uint16_t ROUTED_VERSION = 1;
+static constexpr int ROUTED_FRAME_SIZE = 128;
+
+static constexpr int ROUTED_MAGIC_OFFSET = 0;        // int32
+static constexpr int ROUTED_VERSION_OFFSET = 4;      // int16
+static constexpr int ROUTED_ACTION_OFFSET = 6;       // int16
+static constexpr int ROUTED_TIMESTAMP_OFFSET = 8;    // int64 original publisher timestamp
+static constexpr int ROUTED_SL_POINTS_OFFSET = 16;   // int32 MT5 points
+static constexpr int ROUTED_PT_POINTS_OFFSET = 20;   // int32 MT5 points
+static constexpr int ROUTED_QTY_OFFSET = 24;         // int32
+static constexpr int ROUTED_CONFIDENCE_OFFSET = 28;  // float32
+static constexpr int ROUTED_SYMBOL_OFFSET = 32;      // char[16]
+static constexpr int ROUTED_MT5_SYMBOL_OFFSET = 48;  // char[32]
+static constexpr int ROUTED_SOURCE_OFFSET = 80;      // char[16]
+static constexpr int ROUTED_INSTRUMENT_OFFSET = 96;  // char[32]
+
+static constexpr int MT5_SYMBOL_LEN = 32;
+
+// Heartbeat frame: publisher liveness, sent at a fixed interval by the bridge
+// DLL's heartbeat thread on every publication. Never queued as a signal.
+static constexpr uint32_t HEARTBEAT_MAGIC = 0xA330BEA7;
+static constexpr uint16_t HEARTBEAT_VERSION = 1;
+static constexpr int HEARTBEAT_FRAME_SIZE = 48;
+
+static constexpr int HEARTBEAT_MAGIC_OFFSET = 0;      // int32
+static constexpr int HEARTBEAT_VERSION_OFFSET = 4;    // int16
+static constexpr int HEARTBEAT_FLAGS_OFFSET = 6;      // int16 (reserved)
+static constexpr int HEARTBEAT_TIMESTAMP_OFFSET = 8;  // int64 UTC ns at send
+static constexpr int HEARTBEAT_SEQUENCE_OFFSET = 16;  // int64, +1 per heartbeat
+static constexpr int HEARTBEAT_INTERVAL_OFFSET = 24;  // int32 ms until the next one
+static constexpr int HEARTBEAT_RESERVED_OFFSET = 28;  // int32
+static constexpr int HEARTBEAT_SOURCE_OFFSET = 32;    // char[16]
+
+// State snapshot frame: the last signal frame a publisher sent per
+// (source, instrument), re-sent periodically so late-joining subscribers can
+// seed their state cache. Never queued as a signal.
+static constexpr uint32_t STATE_MAGIC = 0xA3305EED;
+static constexpr uint16_t STATE_VERSION = 1;
+static constexpr int STATE_FRAME_SIZE = 16 + FRAME_SIZE;
+
+static constexpr int STATE_MAGIC_OFFSET = 0;       // int32
+static constexpr int STATE_VERSION_OFFSET = 4;     // int16
+static constexpr int STATE_FLAGS_OFFSET = 6;       // int16 (reserved)
+static constexpr int STATE_SNAPSHOT_OFFSET = 8;    // int64 UTC ns at send
+static constexpr int STATE_SIGNAL_OFFSET = 16;     // FRAME_SIZE bytes: the signal frame as published
+
+// ===============================
+// Little-endian helpers
+// ===============================
+static inline uint16_t rd_u16_le(const uint8_t* p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t rd_u32_le(const uint8_t* p)
+{
+    return (uint32_t)(p[0] | (p[1] << 8) | (p[2] << 16) | (p[3] << 24));
+}
+
+static inline int32_t rd_i32_le(const uint8_t* p)
+{
+    return (int32_t)rd_u32_le(p);
+}
+
+static inline int64_t rd_i64_le(const uint8_t* p)
+{
+    uint64_t v =
+        (uint64_t)p[0] |
+        ((uint64_t)p[1] << 8) |
+        ((uint64_t)p[2] << 16) |
+        ((uint64_t)p[3] << 24) |
+        ((uint64_t)p[4] << 32) |
+        ((uint64_t)p[5] << 40) |
+        ((uint64_t)p[6] << 48) |
+        ((uint64_t)p[7] << 56);
+    return (int64_t)v;
+}
+
+static inline float rd_f32_le(const uint8_t* p)
+{
+    uint32_t u = rd_u32_le(p);
+    float f;
+    std::memcpy(&f, &u, sizeof(float));
+    return f;
+}
+
+static inline void wr_u16_le(uint8_t* p, uint16_t v)
+{
+    p[0] = (uint8_t)(v & 0xFF);
+    p[1] = (uint8_t)((v >> 8) & 0xFF);
+}
+
+static inline void wr_u32_le(uint8_t* p, uint32_t v)
+{
+    p[0] = (uint8_t)(v & 0xFF);
+    p[1] = (uint8_t)((v >> 8) & 0xFF);
+    p[2] = (uint8_t)((v >> 16) & 0xFF);
+    p[3] = (uint8_t)((v >> 24) & 0xFF);
+}
+
+static inline void wr_i32_le(uint8_t* p, int32_t v)
+{
+    wr_u32_le(p, (uint32_t)v);
+}
+
+static inline void wr_i64_le(uint8_t* p, int64_t v)
+{
+    const uint64_t u = (uint64_t)v;
+    for (int i = 0; i < 8; i++)
+        p[i] = (uint8_t)((u >> (8 * i)) & 0xFF);
+}
+
+static inline void wr_f32_le(uint8_t* p, float f)
+{
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(float));
+    wr_u32_le(p, u);
+}
+
+static inline void wr_f64_le(uint8_t* p, double d)
+{
+    uint64_t u;
+    std::memcpy(&u, &d, sizeof(double));
+    wr_i64_le(p, (int64_t)u);
+}
+
+// Copy a NUL-padded ASCII field into a NUL-terminated buffer of len + 1 bytes
+static inline void copy_ascii_trim0(char* out, const uint8_t* p, int len)
+{
+    int end = 0;
+    while (end < len && p[end] != 0) end++;
+    std::memcpy(out, p, (size_t)end);
+    out[end] = '\0';
+}
+
+// Write a string into a fixed NUL-padded field (truncates)
+static inline void write_ascii_pad0(uint8_t* p, const char* s, int len)
+{
+    int i = 0;
+    for (; i < len && s && s[i]; i++) p[i] = (uint8_t)s[i];
+    for (; i < len; i++) p[i] = 0;
+}
+
+// ===============================
+// Frame decode
+// ===============================
+enum FrameCheck
+{
+    FRAME_OK = 0,
+    FRAME_BAD_LENGTH,
+    FRAME_BAD_MAGIC,
+    FRAME_BAD_VERSION
+};
+
+static inline int checkSignalFrame(const uint8_t* buffer, size_t length)
+{
+    if (length < (size_t)FRAME_SIZE) return FRAME_BAD_LENGTH;
+    if (rd_u32_le(buffer + MAGIC_OFFSET) != MAGIC) return FRAME_BAD_MAGIC;
+    if (rd_u16_le(buffer + VERSION_OFFSET) != VERSION) return FRAME_BAD_VERSION;
+    return FRAME_OK;
+}
+
+static inline bool isRoutedFrame(const uint8_t* buffer, size_t length)
+{
+    return length == (size_t)ROUTED_FRAME_SIZE
+        && rd_u32_le(buffer + ROUTED_MAGIC_OFFSET) == ROUTED_MAGIC
+        && rd_u16_le(buffer + ROUTED_VERSION_OFFSET) == ROUTED_VERSION;
+}
+
+static inline bool isHeartbeatFrame(const uint8_t* buffer, size_t length)
+{
+    return length == (size_t)HEARTBEAT_FRAME_SIZE
+        && rd_u32_le(buffer + HEARTBEAT_MAGIC_OFFSET) == HEARTBEAT_MAGIC
+        && rd_u16_le(buffer + HEARTBEAT_VERSION_OFFSET) == HEARTBEAT_VERSION;
+}
+
+// out must hold HEARTBEAT_FRAME_SIZE bytes
+static inline void encodeHeartbeatFrame(uint8_t* out, int64_t nowNs, int64_t sequence, int32_t intervalMs, const char* source)
+{
+    wr_u32_le(out + HEARTBEAT_MAGIC_OFFSET, HEARTBEAT_MAGIC);
+    wr_u16_le(out + HEARTBEAT_VERSION_OFFSET, HEARTBEAT_VERSION);
+    wr_u16_le(out + HEARTBEAT_FLAGS_OFFSET, 0);
+    wr_i64_le(out + HEARTBEAT_TIMESTAMP_OFFSET, nowNs);
+    wr_i64_le(out + HEARTBEAT_SEQUENCE_OFFSET, sequence);
+    wr_i32_le(out + HEARTBEAT_INTERVAL_OFFSET, intervalMs);
+    wr_i32_le(out + HEARTBEAT_RESERVED_OFFSET, 0);
+    write_ascii_pad0(out + HEARTBEAT_SOURCE_OFFSET, source, SOURCE_LEN);
+}
+
+static inline bool isStateFrame(const uint8_t* buffer, size_t length)
+{
+    return length == (size_t)STATE_FRAME_SIZE
+        && rd_u32_le(buffer + STATE_MAGIC_OFFSET) == STATE_MAGIC
+        && rd_u16_le(buffer + STATE_VERSION_OFFSET) == STATE_VERSION;
+}
+
+// out must hold STATE_FRAME_SIZE bytes; signal is a FRAME_SIZE signal frame
+static inline void encodeStateFrame(uint8_t* out, int64_t nowNs, const uint8_t* signal)
+{
+    wr_u32_le(out + STATE_MAGIC_OFFSET, STATE_MAGIC);
+    wr_u16_le(out + STATE_VERSION_OFFSET, STATE_VERSION);
+    wr_u16_le(out + STATE_FLAGS_OFFSET, 0);
+    wr_i64_le(out + STATE_SNAPSHOT_OFFSET, nowNs);
+    std::memcpy(out + STATE_SIGNAL_OFFSET, signal, FRAME_SIZE);
+}
+
+// Exits 5/6 are not forwarded to MT5
+static inline bool isFilteredExit(uint16_t action)
+{
+    return action == 5 || action == 6;
+}
+
+// Determine relevant SL based on direction:
+// action 1/2 = long entries => use longSL
+// action 3/4 = short entries => use shortSL
+static inline int32_t slTicksForAction(uint16_t action, int32_t longSL, int32_t shortSL)
+{
+    if (action == 1 || action == 2) return longSL;
+    if (action == 3 || action == 4) return shortSL;
+    return 0;
+}
+
+// ===============================
+// Instrument mapping + tick conversion
+// ===============================
+// Quantity rounding after a multiplier is applied
+enum QtyRounding
+{
+    QTY_ROUND_NEAREST = 0,
+    QTY_ROUND_DOWN = 1,
+    QTY_ROUND_UP = 2
+};
+
+// Remap table is indexed by incoming action 0..10
+#define ACTION_MAP_SIZE 11
+
+struct InstMap
+{
+    std::string mt5Symbol;   // e.g. "SPX500"
+    double futTickSize;      // e.g. 0.25
+    double mt5PointSize;     // e.g. 0.1 (broker-specific)
+
+    // Decode-stage transforms; the defaults leave a signal unchanged.
+    double qtyMultiplier = 1.0;          // e.g. 2.0 trades twice the futures qty
+    int qtyRounding = QTY_ROUND_NEAREST;
+    int32_t minSlPoints = 0;             // 0 = no limit
+    int32_t maxSlPoints = 0;
+    int32_t minPtPoints = 0;
+    int32_t maxPtPoints = 0;
+    bool reverse = false;                // trade the opposite direction
+    uint8_t actionMap[ACTION_MAP_SIZE] = {};  // 0 = keep incoming action
+};
+
+static inline bool hasTransforms(const InstMap& m)
+{
+    if (m.qtyMultiplier != 1.0 || m.reverse) return true;
+    if (m.minSlPoints > 0 || m.maxSlPoints > 0 || m.minPtPoints > 0 || m.maxPtPoints > 0) return true;
+    for (int i = 0; i < ACTION_MAP_SIZE; i++)
+        if (m.actionMap[i] != 0) return true;
+    return false;
+}
+
+// Long/short counterpart of an action; force exit and unknown codes are unchanged
+static inline uint16_t reverseAction(uint16_t action)
+{
+    switch (action)
+    {
+    case 1: return 3;
+    case 2: return 4;
+    case 3: return 1;
+    case 4: return 2;
+    case 5: return 6;
+    case 6: return 5;
+    case 7: return 8;
+    case 8: return 7;
+    default: return action;
+    }
+}
+
+// Only a set SL/PT (> 0) is clamped; 0 stays "none"
+static inline int32_t clampPoints(int32_t points, int32_t minPoints, int32_t maxPoints)
+{
+    if (points <= 0) return points;
+    if (minPoints > 0 && points < minPoints) return minPoints;
+    if (maxPoints > 0 && points > maxPoints) return maxPoints;
+    return points;
+}
+
+// Transform chain, in order: action remap, reversal, qty scaling, SL/PT clamp.
+// SL/PT distances carry over unchanged when the direction flips.
+// Returns true if anything changed.
+static inline bool applyTransforms(const InstMap& m,
+    uint16_t& action, int32_t& qty, int32_t& slPoints, int32_t& ptPoints)
+{
+    const uint16_t a0 = action;
+    const int32_t q0 = qty, sl0 = slPoints, pt0 = ptPoints;
+
+    if (action < ACTION_MAP_SIZE && m.actionMap[action] != 0)
+        action = m.actionMap[action];
+    if (m.reverse)
+        action = reverseAction(action);
+
+    if (m.qtyMultiplier != 1.0 && qty > 0)
+    {
+        const double scaled = (double)qty * m.qtyMultiplier;
+        double rounded;
+        if (m.qtyRounding == QTY_ROUND_DOWN) rounded = std::floor(scaled);
+        else if (m.qtyRounding == QTY_ROUND_UP) rounded = std::ceil(scaled);
+        else rounded = std::floor(scaled + 0.5);
+        // Scaling never turns a sized signal into a zero-size one
+        if (rounded < 1.0) rounded = 1.0;
+        if (rounded > 2147483647.0) rounded = 2147483647.0;
+        qty = (int32_t)rounded;
+    }
+
+    slPoints = clampPoints(slPoints, m.minSlPoints, m.maxSlPoints);
+    ptPoints = clampPoints(ptPoints, m.minPtPoints, m.maxPtPoints);
+
+    return action != a0 || qty != q0 || slPoints != sl0 || ptPoints != pt0;
+}
+
+// Length of the futures prefix of a NUL-terminated instrument (no allocation)
+static inline size_t futPrefixLength(const char* instrument)
+{
+    // "ES MAR26" -> "ES"
+    // "NQ MAR26" -> "NQ"
+    const char* space = std::strchr(instrument, ' ');
+    return space ? (size_t)(space - instrument) : std::strlen(instrument);
+}
+
+static inline int ticksToPoints(int ticks, double futTickSize, double mt5PointSize)
+{
+    // priceMove = ticks * futTickSize
+    // mt5Points = priceMove / mt5PointSize
+    if (ticks <= 0) return 0;
+    if (futTickSize <= 0.0 || mt5PointSize <= 0.0) return 0;
+    double priceMove = (double)ticks * futTickSize;
+    double pts = priceMove / mt5PointSize;
+    // round to nearest int (safer than trunc)
+    if (pts < 0) pts = 0;
+    return (int)(pts + 0.5);
+}
+
+static inline int ticksToMt5Points(int ticks, const InstMap& m)
+{
+    return ticksToPoints(ticks, m.futTickSize, m.mt5PointSize);
+}
+
+// Build a routed frame from a validated source frame and its mapping.
+// out must hold ROUTED_FRAME_SIZE bytes.
+static inline void encodeRoutedFrame(uint8_t* out, const uint8_t* src, const InstMap& map)
+{
+    const uint16_t action = rd_u16_le(src + ACTION_OFFSET);
+    const int32_t slTicks = slTicksForAction(action,
+        rd_i32_le(src + LONG_SL_OFFSET), rd_i32_le(src + SHORT_SL_OFFSET));
+
+    wr_u32_le(out + ROUTED_MAGIC_OFFSET, ROUTED_MAGIC);
+    wr_u16_le(out + ROUTED_VERSION_OFFSET, ROUTED_VERSION);
+    wr_u16_le(out + ROUTED_ACTION_OFFSET, action);
+    wr_i64_le(out + ROUTED_TIMESTAMP_OFFSET, rd_i64_le(src + TIMESTAMP_OFFSET));
+    wr_i32_le(out + ROUTED_SL_POINTS_OFFSET, ticksToMt5Points(slTicks, map));
+    wr_i32_le(out + ROUTED_PT_POINTS_OFFSET, ticksToMt5Points(rd_i32_le(src + PROFIT_TARGET_OFFSET), map));
+    wr_i32_le(out + ROUTED_QTY_OFFSET, rd_i32_le(src + QTY_OFFSET));
+    std::memcpy(out + ROUTED_CONFIDENCE_OFFSET, src + CONFIDENCE_OFFSET, 4);
+    std::memcpy(out + ROUTED_SYMBOL_OFFSET, src + SYMBOL_OFFSET, SYMBOL_LEN);
+    write_ascii_pad0(out + ROUTED_MT5_SYMBOL_OFFSET, map.mt5Symbol.c_str(), MT5_SYMBOL_LEN);
+    std::memcpy(out + ROUTED_SOURCE_OFFSET, src + SOURCE_OFFSET, SOURCE_LEN);
+    std::memcpy(out + ROUTED_INSTRUMENT_OFFSET, src + INSTRUMENT_OFFSET, INSTRUMENT_LEN);
+}
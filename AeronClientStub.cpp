@@ -0,0 +1,208 @@
+// AeronClientStub.cpp — in-process stand-in for the Aeron C client, used by the
+// AeronBridgeAllocTest console target. Compiled against the real Aeron headers
+// so signatures stay in lock-step with the library AeronBridge.dll links; no
+// Media Driver is needed.
+//
+// Subscriptions replay a caller-supplied frame array; publications count offers.
+// Nothing here allocates after start-up: handles are slots in static pools.
+
+#include <aeronc.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+    struct StubPublication
+    {
+        int32_t streamId;
+    };
+
+    // Opaque handles: the bridge only ever passes these back to us.
+    unsigned char g_client;
+    unsigned char g_context;
+    unsigned char g_subscriptions[64];
+    unsigned char g_asyncAdd[256];
+    StubPublication g_publications[64];
+    int g_publicationCount = 0;
+    int64_t g_counters[256];
+    int g_counterCount = 0;
+    int64_t g_readerValues[64];
+
+    const uint8_t* g_feed = nullptr;
+    size_t g_feedFrameSize = 0;
+    size_t g_feedCount = 0;
+    size_t g_feedCursor = 0;
+    int64_t g_offers = 0;
+
+    template <typename T>
+    T* handle(void* p) { return reinterpret_cast<T*>(p); }
+}
+
+// Test hooks (declared in AeronBridgeAllocTest.cpp).
+void aeronStubSetFeed(const uint8_t* frames, size_t frameSize, size_t count)
+{
+    g_feed = frames;
+    g_feedFrameSize = frameSize;
+    g_feedCount = count;
+    g_feedCursor = 0;
+}
+
+size_t aeronStubPending() { return g_feedCount - g_feedCursor; }
+
+int64_t aeronStubOffers() { return g_offers; }
+
+extern "C" {
+
+int aeron_context_init(aeron_context_t** context) { *context = handle<aeron_context_t>(&g_context); return 0; }
+int aeron_context_close(aeron_context_t*) { return 0; }
+int aeron_context_set_dir(aeron_context_t*, const char*) { return 0; }
+int aeron_context_set_pre_touch_mapped_memory(aeron_context_t*, bool) { return 0; }
+int aeron_init(aeron_t** client, aeron_context_t*) { *client = handle<aeron_t>(&g_client); return 0; }
+int aeron_start(aeron_t*) { return 0; }
+int aeron_close(aeron_t*) { return 0; }
+const char* aeron_errmsg(void) { return "aeron stub"; }
+
+int aeron_async_add_subscription(aeron_async_add_subscription_t** async, aeron_t*, const char*, int32_t streamId,
+    aeron_on_available_image_t, void*, aeron_on_unavailable_image_t, void*)
+{
+    *async = handle<aeron_async_add_subscription_t>(&g_asyncAdd[(size_t)streamId % sizeof(g_asyncAdd)]);
+    return 0;
+}
+
+int aeron_async_add_subscription_poll(aeron_subscription_t** subscription, aeron_async_add_subscription_t* async)
+{
+    const size_t slot = (size_t)(reinterpret_cast<unsigned char*>(async) - g_asyncAdd);
+    *subscription = handle<aeron_subscription_t>(&g_subscriptions[slot % sizeof(g_subscriptions)]);
+    return 1;
+}
+
+int aeron_subscription_poll(aeron_subscription_t*, aeron_fragment_handler_t handler, void* clientd, size_t fragmentLimit)
+{
+    int n = 0;
+    while ((size_t)n < fragmentLimit && g_feedCursor < g_feedCount)
+    {
+        handler(clientd, g_feed + g_feedCursor * g_feedFrameSize, g_feedFrameSize, nullptr);
+        ++g_feedCursor;
+        ++n;
+    }
+    return n;
+}
+
+int aeron_subscription_controlled_poll(aeron_subscription_t*, aeron_controlled_fragment_handler_t handler, void* clientd, size_t fragmentLimit)
+{
+    int n = 0;
+    while ((size_t)n < fragmentLimit && g_feedCursor < g_feedCount)
+    {
+        const aeron_controlled_fragment_handler_action_t action =
+            handler(clientd, g_feed + g_feedCursor * g_feedFrameSize, g_feedFrameSize, nullptr);
+        if (action == AERON_ACTION_ABORT)
+            break;
+        ++g_feedCursor;
+        ++n;
+        if (action == AERON_ACTION_BREAK)
+            break;
+    }
+    return n;
+}
+
+int aeron_subscription_close(aeron_subscription_t*, aeron_notification_t, void*) { return 0; }
+
+int aeron_subscription_constants(aeron_subscription_t*, aeron_subscription_constants_t* constants)
+{
+    std::memset(constants, 0, sizeof(*constants));
+    return 0;
+}
+
+int aeron_image_constants(aeron_image_t*, aeron_image_constants_t* constants)
+{
+    std::memset(constants, 0, sizeof(*constants));
+    return 0;
+}
+
+int64_t aeron_image_position(aeron_image_t*) { return 0; }
+bool aeron_image_is_end_of_stream(aeron_image_t*) { return false; }
+
+int aeron_header_values(aeron_header_t*, aeron_header_values_t* values)
+{
+    std::memset(values, 0, sizeof(*values));
+    values->frame.session_id = 1;
+    return 0;
+}
+
+int aeron_async_add_publication(aeron_async_add_publication_t** async, aeron_t*, const char*, int32_t streamId)
+{
+    if (g_publicationCount >= (int)(sizeof(g_publications) / sizeof(g_publications[0])))
+        return -1;
+    g_publications[g_publicationCount].streamId = streamId;
+    *async = handle<aeron_async_add_publication_t>(&g_publications[g_publicationCount++]);
+    return 0;
+}
+
+int aeron_async_add_publication_poll(aeron_publication_t** publication, aeron_async_add_publication_t* async)
+{
+    *publication = handle<aeron_publication_t>(async);
+    return 1;
+}
+
+int64_t aeron_publication_offer(aeron_publication_t*, const uint8_t*, size_t length, aeron_reserved_value_supplier_t, void*)
+{
+    ++g_offers;
+    return (int64_t)length;
+}
+
+int aeron_publication_close(aeron_publication_t*, aeron_notification_t, void*) { return 0; }
+
+int aeron_publication_constants(aeron_publication_t* publication, aeron_publication_constants_t* constants)
+{
+    std::memset(constants, 0, sizeof(*constants));
+    constants->channel = "aeron:ipc";
+    constants->stream_id = reinterpret_cast<StubPublication*>(publication)->streamId;
+    return 0;
+}
+
+bool aeron_publication_is_connected(aeron_publication_t*) { return true; }
+int64_t aeron_publication_position(aeron_publication_t*) { return 0; }
+int64_t aeron_publication_position_limit(aeron_publication_t*) { return INT64_MAX; }
+int64_t aeron_publication_channel_status(aeron_publication_t*) { return AERON_COUNTER_CHANNEL_ENDPOINT_STATUS_ACTIVE; }
+
+int aeron_publication_async_add_destination(aeron_async_destination_t** async, aeron_t*, aeron_publication_t*, const char*)
+{
+    *async = handle<aeron_async_destination_t>(&g_asyncAdd[0]);
+    return 0;
+}
+
+int aeron_publication_async_remove_destination(aeron_async_destination_t** async, aeron_t*, aeron_publication_t*, const char*)
+{
+    *async = handle<aeron_async_destination_t>(&g_asyncAdd[0]);
+    return 0;
+}
+
+int aeron_publication_async_destination_poll(aeron_async_destination_t*) { return 1; }
+
+int aeron_async_add_counter(aeron_async_add_counter_t** async, aeron_t*, int32_t, const uint8_t*, size_t, const char*, size_t)
+{
+    if (g_counterCount >= (int)(sizeof(g_counters) / sizeof(g_counters[0])))
+        return -1;
+    *async = handle<aeron_async_add_counter_t>(&g_counters[g_counterCount++]);
+    return 0;
+}
+
+int aeron_async_add_counter_poll(aeron_counter_t** counter, aeron_async_add_counter_t* async)
+{
+    *counter = handle<aeron_counter_t>(async);
+    return 1;
+}
+
+int64_t* aeron_counter_addr(aeron_counter_t* counter) { return reinterpret_cast<int64_t*>(counter); }
+int aeron_counter_close(aeron_counter_t*, aeron_notification_t, void*) { return 0; }
+
+aeron_counters_reader_t* aeron_counters_reader(aeron_t*) { return handle<aeron_counters_reader_t>(g_readerValues); }
+void aeron_counters_reader_foreach_counter(aeron_counters_reader_t*, aeron_counters_reader_foreach_counter_func_t, void*) {}
+
+int64_t* aeron_counters_reader_addr(aeron_counters_reader_t*, int32_t counterId)
+{
+    return &g_readerValues[(size_t)counterId % (sizeof(g_readerValues) / sizeof(g_readerValues[0]))];
+}
+
+} // extern "C"
@@ -0,0 +1,438 @@
+// AeronSignalRouter.cpp — headless signal router (Linux) built from the bridge core
+//
+// Subscribes once to the publisher feed, applies every broker profile's
+// instrument mapping + tick conversion (AeronBridgeCore.h) and republishes
+// pre-mapped routed frames per profile. MT5 terminals point AeronBridge_StartW
+// at their profile's stream and receive ready-to-trade signals; mapping
+// changes are made here, in one place.
+//
+// Build (Linux, Aeron C client):
+//   make -f Makefile.router AERON_DIR=<aeron> [AERON_BUILD=<aeron-build>/lib]
+//
+// Usage:
+//   aeron_signal_router -c aeron:udp?endpoint=239.10.10.1:40123 -s 1001
+//       -o aeron:udp?endpoint=239.10.10.2:40124
+//       -p broker_a=broker_a_mappings.csv@2001 -p broker_b=broker_b_mappings.csv@2002
+//
+// The default aeron:ipc output only reaches subscribers on the same host and
+// Media Driver. MT5 terminals on other machines (the usual Windows setup) need
+// a UDP output channel (multicast, or a unicast endpoint per terminal host).
+//
+//   -d <dir>        Aeron directory (default: driver default)
+//   -c <channel>    source channel
+//   -s <stream>     source stream id
+//   -o <channel>    output channel (default aeron:ipc, same host only)
+//   -p name=csv@stream  broker profile; repeat per broker/terminal
+//   -i <seconds>    stats interval (default 10, 0 = off)
+//
+// SIGHUP reloads every profile's mapping CSV; SIGINT/SIGTERM stop the router.
+
+#include "AeronBridgeCore.h"
+
+#include <aeronc.h>
+
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// ===============================
+// Profiles
+// ===============================
+struct RouterProfile
+{
+    std::string name;
+    std::string csvPath;
+    int streamId;
+    std::unordered_map<std::string, InstMap> map;
+    aeron_publication_t* publication;
+
+    int64_t routed;
+    int64_t unmapped;
+    int64_t notConnected;
+    int64_t backPressured;
+    int64_t failed;
+};
+
+struct RouterStats
+{
+    int64_t fragments;
+    int64_t rejected;
+    int64_t exitsFiltered;
+    int64_t heartbeats;
+};
+
+static std::vector<RouterProfile> g_profiles;
+static RouterStats g_stats{};
+
+static volatile std::sig_atomic_t g_running = 1;
+static volatile std::sig_atomic_t g_reload = 0;
+
+static constexpr int OFFER_RETRIES = 3;
+static constexpr int FRAGMENT_LIMIT = 64;
+
+static void onSignal(int sig)
+{
+    if (sig == SIGHUP) g_reload = 1;
+    else g_running = 0;
+}
+
+static std::string trim(const std::string& s)
+{
+    size_t b = 0, e = s.size();
+    while (b < e && (s[b] == ' ' || s[b] == '\t' || s[b] == '\r' || s[b] == '\n')) b++;
+    while (e > b && (s[e - 1] == ' ' || s[e - 1] == '\t' || s[e - 1] == '\r' || s[e - 1] == '\n')) e--;
+    return s.substr(b, e - b);
+}
+
+// FutPrefix,MT5Symbol,TickSize,PointSize (same layout as broker_a_mappings.csv)
+static bool loadMappingCsv(const std::string& path, std::unordered_map<std::string, InstMap>& out)
+{
+    FILE* f = std::fopen(path.c_str(), "r");
+    if (!f)
+    {
+        std::fprintf(stderr, "router: cannot open mapping file '%s'\n", path.c_str());
+        return false;
+    }
+
+    std::unordered_map<std::string, InstMap> map;
+    char line[256];
+    int lineNo = 0;
+    while (std::fgets(line, sizeof(line), f))
+    {
+        lineNo++;
+        const std::string row = trim(line);
+        if (row.empty() || row[0] == '#') continue;
+        if (row.rfind("FutPrefix", 0) == 0) continue;  // header
+
+        std::string fields[4];
+        size_t start = 0;
+        int n = 0;
+        for (; n < 4; n++)
+        {
+            const size_t comma = row.find(',', start);
+            fields[n] = trim(row.substr(start, comma == std::string::npos ? std::string::npos : comma - start));
+            if (comma == std::string::npos) { n++; break; }
+            start = comma + 1;
+        }
+
+        const double tick = n == 4 ? std::atof(fields[2].c_str()) : 0.0;
+        const double point = n == 4 ? std::atof(fields[3].c_str()) : 0.0;
+        if (n != 4 || fields[0].empty() || fields[1].empty() || tick <= 0.0 || point <= 0.0)
+        {
+            std::fprintf(stderr, "router: %s:%d: expected FutPrefix,MT5Symbol,TickSize,PointSize\n", path.c_str(), lineNo);
+            std::fclose(f);
+            return false;
+        }
+        map[fields[0]] = InstMap{ fields[1], tick, point };
+    }
+    std::fclose(f);
+
+    out.swap(map);
+    return true;
+}
+
+// name=csv@stream
+static bool parseProfileArg(const char* arg, RouterProfile& p)
+{
+    const std::string s(arg);
+    const size_t eq = s.find('=');
+    const size_t at = s.rfind('@');
+    if (eq == std::string::npos || at == std::string::npos || at < eq) return false;
+
+    p.name = s.substr(0, eq);
+    p.csvPath = s.substr(eq + 1, at - eq - 1);
+    p.streamId = std::atoi(s.c_str() + at + 1);
+    return !p.name.empty() && !p.csvPath.empty() && p.streamId > 0;
+}
+
+static void reloadMappings()
+{
+    for (auto& p : g_profiles)
+    {
+        std::unordered_map<std::string, InstMap> map;
+        if (loadMappingCsv(p.csvPath, map))
+        {
+            p.map.swap(map);
+            std::printf("router: profile '%s' reloaded %zu mappings\n", p.name.c_str(), p.map.size());
+        }
+        else
+        {
+            std::fprintf(stderr, "router: profile '%s' keeps previous mappings\n", p.name.c_str());
+        }
+    }
+    std::fflush(stdout);
+}
+
+// ===============================
+// Fragment handler
+// ===============================
+static void offerRouted(RouterProfile& p, const uint8_t* frame, size_t length)
+{
+    for (int attempt = 0; attempt <= OFFER_RETRIES; attempt++)
+    {
+        const int64_t res = aeron_publication_offer(p.publication, frame, length, nullptr, nullptr);
+        if (res > 0)
+        {
+            p.routed++;
+            return;
+        }
+        if (res == AERON_PUBLICATION_NOT_CONNECTED)
+        {
+            p.notConnected++;  // terminal not running: nothing to retry
+            return;
+        }
+        if (res != AERON_PUBLICATION_BACK_PRESSURED && res != AERON_PUBLICATION_ADMIN_ACTION)
+        {
+            p.failed++;
+            return;
+        }
+    }
+    p.backPressured++;
+}
+
+static void onFragment(
+    void* /*clientd*/,
+    const uint8_t* buffer,
+    size_t length,
+    aeron_header_t* /*header*/)
+{
+    g_stats.fragments++;
+
+    // Publisher heartbeats and state snapshots go to every profile unchanged
+    // so terminals behind the router still see liveness and can resync
+    if (buffer && (isHeartbeatFrame(buffer, length) || isStateFrame(buffer, length)))
+    {
+        g_stats.heartbeats++;
+        for (auto& p : g_profiles)
+            offerRouted(p, buffer, length);
+        return;
+    }
+
+    if (!buffer || checkSignalFrame(buffer, length) != FRAME_OK)
+    {
+        g_stats.rejected++;
+        return;
+    }
+
+    const uint16_t action = rd_u16_le(buffer + ACTION_OFFSET);
+    if (isFilteredExit(action))
+    {
+        g_stats.exitsFiltered++;
+        return;
+    }
+
+    char inst[INSTRUMENT_LEN + 1];
+    copy_ascii_trim0(inst, buffer + INSTRUMENT_OFFSET, INSTRUMENT_LEN);
+    static std::string prefix;  // reused lookup key (single poll thread)
+    prefix.assign(inst, futPrefixLength(inst));
+
+    uint8_t routed[ROUTED_FRAME_SIZE];
+    for (auto& p : g_profiles)
+    {
+        auto it = p.map.find(prefix);
+        if (it == p.map.end())
+        {
+            p.unmapped++;
+            continue;
+        }
+        encodeRoutedFrame(routed, buffer, it->second);
+        offerRouted(p, routed, ROUTED_FRAME_SIZE);
+    }
+}
+
+static void printStats()
+{
+    std::printf("router: fragments=%lld rejected=%lld exits_filtered=%lld heartbeats=%lld\n",
+        (long long)g_stats.fragments, (long long)g_stats.rejected, (long long)g_stats.exitsFiltered,
+        (long long)g_stats.heartbeats);
+    for (const auto& p : g_profiles)
+    {
+        std::printf("router:   %s stream=%d routed=%lld unmapped=%lld not_connected=%lld back_pressured=%lld failed=%lld\n",
+            p.name.c_str(), p.streamId, (long long)p.routed, (long long)p.unmapped,
+            (long long)p.notConnected, (long long)p.backPressured, (long long)p.failed);
+    }
+    std::fflush(stdout);
+}
+
+// ===============================
+// Aeron setup
+// ===============================
+static bool awaitPublication(aeron_t* aeron, const char* channel, int streamId, aeron_publication_t** out)
+{
+    aeron_async_add_publication_t* async = nullptr;
+    if (aeron_async_add_publication(&async, aeron, channel, streamId) < 0)
+        return false;
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (g_running)
+    {
+        const int res = aeron_async_add_publication_poll(out, async);
+        if (res < 0) return false;
+        if (res > 0) return true;
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+static bool awaitSubscription(aeron_t* aeron, const char* channel, int streamId, aeron_subscription_t** out)
+{
+    aeron_async_add_subscription_t* async = nullptr;
+    if (aeron_async_add_subscription(&async, aeron, channel, streamId, nullptr, nullptr, nullptr, nullptr) < 0)
+        return false;
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (g_running)
+    {
+        const int res = aeron_async_add_subscription_poll(out, async);
+        if (res < 0) return false;
+        if (res > 0) return true;
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+static void usage()
+{
+    std::fprintf(stderr,
+        "usage: aeron_signal_router -c <channel> -s <stream> -p name=csv@stream [-p ...]\n"
+        "                           [-d <aeron dir>] [-o <output channel>] [-i <stats seconds>]\n");
+}
+
+int main(int argc, char** argv)
+{
+    std::string aeronDir;
+    std::string channel;
+    std::string outChannel = "aeron:ipc";
+    int streamId = 0;
+    int statsSeconds = 10;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string opt = argv[i];
+        if (i + 1 >= argc) { usage(); return 2; }
+        const char* val = argv[++i];
+        if (opt == "-d") aeronDir = val;
+        else if (opt == "-c") channel = val;
+        else if (opt == "-s") streamId = std::atoi(val);
+        else if (opt == "-o") outChannel = val;
+        else if (opt == "-i") statsSeconds = std::atoi(val);
+        else if (opt == "-p")
+        {
+            RouterProfile p{};
+            if (!parseProfileArg(val, p))
+            {
+                std::fprintf(stderr, "router: bad profile '%s' (expected name=csv@stream)\n", val);
+                return 2;
+            }
+            g_profiles.push_back(p);
+        }
+        else { usage(); return 2; }
+    }
+
+    if (channel.rfind("aeron:", 0) != 0 || streamId <= 0 || g_profiles.empty())
+    {
+        usage();
+        return 2;
+    }
+
+    for (auto& p : g_profiles)
+    {
+        if (!loadMappingCsv(p.csvPath, p.map)) return 1;
+        std::printf("router: profile '%s' -> %s stream %d (%zu mappings)\n",
+            p.name.c_str(), outChannel.c_str(), p.streamId, p.map.size());
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::signal(SIGHUP, onSignal);
+
+    aeron_context_t* context = nullptr;
+    aeron_t* aeron = nullptr;
+    if (aeron_context_init(&context) < 0)
+    {
+        std::fprintf(stderr, "router: aeron_context_init failed: %s\n", aeron_errmsg());
+        return 1;
+    }
+    if (!aeronDir.empty())
+        aeron_context_set_dir(context, aeronDir.c_str());
+    if (aeron_init(&aeron, context) < 0 || aeron_start(aeron) < 0)
+    {
+        std::fprintf(stderr, "router: aeron start failed: %s\n", aeron_errmsg());
+        aeron_context_close(context);
+        return 1;
+    }
+
+    int rc = 0;
+    aeron_subscription_t* subscription = nullptr;
+    for (auto& p : g_profiles)
+    {
+        if (!awaitPublication(aeron, outChannel.c_str(), p.streamId, &p.publication))
+        {
+            std::fprintf(stderr, "router: publication for '%s' failed: %s\n", p.name.c_str(), aeron_errmsg());
+            rc = 1;
+            break;
+        }
+    }
+    if (rc == 0 && !awaitSubscription(aeron, channel.c_str(), streamId, &subscription))
+    {
+        std::fprintf(stderr, "router: subscribe failed: %s\n", aeron_errmsg());
+        rc = 1;
+    }
+
+    if (rc == 0)
+    {
+        std::printf("router: subscribed to %s stream %d\n", channel.c_str(), streamId);
+        std::fflush(stdout);
+
+        auto nextStats = std::chrono::steady_clock::now() + std::chrono::seconds(statsSeconds);
+        int idle = 0;
+        while (g_running)
+        {
+            if (g_reload)
+            {
+                g_reload = 0;
+                reloadMappings();
+            }
+
+            const int fragments = aeron_subscription_poll(subscription, onFragment, nullptr, FRAGMENT_LIMIT);
+            if (fragments < 0)
+            {
+                std::fprintf(stderr, "router: poll failed: %s\n", aeron_errmsg());
+                rc = 1;
+                break;
+            }
+
+            // Spin, then yield, then park: low latency while busy, no CPU burn while idle
+            if (fragments > 0) idle = 0;
+            else if (++idle < 100) {}
+            else if (idle < 200) std::this_thread::yield();
+            else std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+            if (statsSeconds > 0 && std::chrono::steady_clock::now() >= nextStats)
+            {
+                printStats();
+                nextStats = std::chrono::steady_clock::now() + std::chrono::seconds(statsSeconds);
+            }
+        }
+    }
+
+    printStats();
+
+    if (subscription) aeron_subscription_close(subscription, nullptr, nullptr);
+    for (auto& p : g_profiles)
+    {
+        if (p.publication) aeron_publication_close(p.publication, nullptr, nullptr);
+    }
+    aeron_close(aeron);
+    aeron_context_close(context);
+    return rc;
+}